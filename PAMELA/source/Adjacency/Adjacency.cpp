@@ -42,6 +42,12 @@ namespace PAMELA
 	}
 
 
+	Adjacency* Adjacency::dualGraph(Adjacency* input)
+	{
+		return new Adjacency(input->get_targetFamily(), input->get_targetFamily(), input->get_sourceFamily(), input->m_targetElementCollection, input->m_targetElementCollection, input->m_sourceElementCollection,
+			CSRMatrix::dualGraph(input->m_adjacencySparseMatrix));
+	}
+
 	Adjacency* Adjacency::multiply(Adjacency* input_lhs, Adjacency* input_rhs)
 	{
 		Adjacency* adj = new Adjacency(input_rhs->get_targetFamily(), input_lhs->get_sourceFamily(), input_lhs->get_targetFamily(), input_rhs->m_targetElementCollection, input_lhs->m_sourceElementCollection, input_lhs->m_targetElementCollection);
@@ -45,6 +45,8 @@ namespace PAMELA
 		//Utils
 		static Adjacency* transposed(Adjacency* input);
 		static Adjacency* multiply(Adjacency* input_lhs, Adjacency* input_rhs);
+		//Targets linked by a source, such as cells sharing a face from face to cell, the source is the value
+		static Adjacency* dualGraph(Adjacency* input);
 		
 		ParallelEnsembleBase* get_sourceElementCollection() const { return m_sourceElementCollection; }
 		ParallelEnsembleBase* get_targetElementCollection() const { return m_targetElementCollection; }
@@ -59,21 +59,41 @@ namespace PAMELA
 			return get_TopologicalAdjacency(m_mesh->get_PolyhedronCollection(), m_mesh->get_PolyhedronCollection(), m_mesh->get_PolygonCollection());
 		}
 
+		// SOURCE = POLYHEDRON ; TARGET = LINE ; BASE = POLYHEDRON
+		if ((source == ELEMENTS::FAMILY::POLYHEDRON) && (target == ELEMENTS::FAMILY::LINE) && (base == ELEMENTS::FAMILY::POLYHEDRON))
+		{
+			return get_TopologicalAdjacency(m_mesh->get_PolyhedronCollection(), m_mesh->get_LineCollection(), m_mesh->get_PolyhedronCollection());
+		}
+
+		// SOURCE = LINE ; TARGET = POLYHEDRON ; BASE = POLYHEDRON
+		if ((source == ELEMENTS::FAMILY::LINE) && (target == ELEMENTS::FAMILY::POLYHEDRON) && (base == ELEMENTS::FAMILY::POLYHEDRON))
+		{
+			return get_TopologicalAdjacency(m_mesh->get_LineCollection(), m_mesh->get_PolyhedronCollection(), m_mesh->get_PolyhedronCollection());
+		}
+
+		// SOURCE = LINE ; TARGET = POINT ; BASE = LINE
+		if ((source == ELEMENTS::FAMILY::LINE) && (target == ELEMENTS::FAMILY::POINT) && (base == ELEMENTS::FAMILY::LINE))
+		{
+			return get_TopologicalAdjacency(m_mesh->get_LineCollection(), m_mesh->get_PointCollection(), m_mesh->get_LineCollection());
+		}
+
 		LOGERROR("Adjacency not implemented yet");
 		return nullptr;
 
 
 	}
 
-	void AdjacencySet::ClearAfterPartitioning(std::set<int>& PolyhedronOwned, std::set<int>& PolyheronGhost,std::set<int>& PolygonOwned, std::set<int>& PolygonGhost)
+	void AdjacencySet::ClearAfterPartitioning(const PartitionFilter& PolyhedronFilter, const PartitionFilter& PolygonFilter)
 	{
 
-                utils::pamela_unused(PolyhedronOwned);
-                utils::pamela_unused(PolyheronGhost);
+                utils::pamela_unused(PolyhedronFilter);
 		//Topological
 		auto adjacency = get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON);
-		auto new_adjacency = ClearAfterPartitioning_Topological(adjacency, PolygonOwned, PolygonGhost);
-		delete adjacency;
+		auto new_adjacency = ClearAfterPartitioning_Topological(adjacency, PolygonFilter);
+		for (auto& topological : TopologicalAdjacencyMap)
+		{
+			delete topological.second;
+		}
 		TopologicalAdjacencyMap.clear();
 		TopologicalAdjacencyMap[std::make_tuple(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON)] = new_adjacency;
 
@@ -85,7 +105,7 @@ namespace PAMELA
 			auto label = it->first;
 			if((adj->get_sourceFamily()==ELEMENTS::FAMILY::POLYHEDRON)&& (adj->get_targetFamily() == ELEMENTS::FAMILY::POLYHEDRON)&& (adj->get_baseFamily() == ELEMENTS::FAMILY::UNKNOWN))
 			{
-				ClearAfterPartitioning_NonTopological(adj, PolyhedronOwned, PolyheronGhost);
+				ClearAfterPartitioning_NonTopological(adj, PolyhedronFilter);
 				NonTopologicalAdjacencyMap[label] = adj;
 			}
 		}*/
@@ -94,7 +114,7 @@ namespace PAMELA
 
 
 
-	Adjacency* AdjacencySet::ClearAfterPartitioning_Topological(Adjacency* adjacency, std::set<int>& PolygonOwned, std::set<int>& PolygonGhost)
+	Adjacency* AdjacencySet::ClearAfterPartitioning_Topological(Adjacency* adjacency, const PartitionFilter& PolygonFilter)
 	{
 		auto polyhedra = static_cast<PolyhedronCollection*>(adjacency->get_sourceElementCollection());
 		auto polygons = static_cast<PolygonCollection*>(adjacency->get_targetElementCollection());
@@ -109,6 +129,8 @@ namespace PAMELA
 		auto& new_columIndex = new_csr_matrix->columnIndex;
 		auto& new_rowPtr = new_csr_matrix->rowPtr;
 		auto& new_val = new_csr_matrix->values;
+		new_csr_matrix->dimRow = new_csr_matrix->dimRow_owned = static_cast<int>(polyhedra->size_all());
+		new_csr_matrix->dimColumn = new_csr_matrix->dimColumn_owned = static_cast<int>(polygons->size_all());
 
 		for (auto it = polyhedra->begin(); it != polyhedra->end(); ++it)
 		{
@@ -123,7 +145,7 @@ namespace PAMELA
 			{
 				auto polygon_global_index = sub_columnIndex[i];
 
-				if ((PolygonOwned.count(polygon_global_index) == 1) || (PolygonGhost.count(polygon_global_index) == 1))	//face is in the partition
+				if (PolygonFilter.is_kept(polygon_global_index))	//face is in the partition
 				{
 					auto polygon_local_index = polygons->get_GlobalToLocalIndex().at(polygon_global_index);
 					temp.push_back(polygon_local_index);
@@ -135,11 +157,11 @@ namespace PAMELA
 			new_columIndex.insert(new_columIndex.end(), temp.begin(), temp.end());
 			new_rowPtr.push_back(new_nnz);
 		}
-		return new Adjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON, polyhedra, polyhedra, polygons, new_csr_matrix);
+		return new Adjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON, polyhedra, polygons, polyhedra, new_csr_matrix);
 	}
 
 
-	Adjacency* AdjacencySet::ClearAfterPartitioning_NonTopological(Adjacency* adjacency, std::set<int>& Polyhedron_owned, std::set<int>& Polyhedron_ghost)
+	Adjacency* AdjacencySet::ClearAfterPartitioning_NonTopological(Adjacency* adjacency, const PartitionFilter& PolyhedronFilter)
 	{
 		auto polyhedra = static_cast<PolyhedronCollection*>(adjacency->get_sourceElementCollection());
 		auto csr_matrix = adjacency->get_adjacencySparseMatrix();
@@ -167,7 +189,7 @@ namespace PAMELA
 			{
 				auto polyhedron2_global_index = sub_columnIndex[i];
 
-				if ((Polyhedron_owned.count(polyhedron2_global_index) == 1) || (Polyhedron_ghost.count(polyhedron2_global_index) == 1))	//face is in the partition
+				if (PolyhedronFilter.is_kept(polyhedron2_global_index))	//face is in the partition
 				{
 					auto polyhedron2_local_index = polyhedra->get_GlobalToLocalIndex().at(polyhedron2_global_index);
 					temp.push_back(polyhedron2_local_index);
@@ -209,31 +231,30 @@ namespace PAMELA
 	{
 
 		Adjacency* adj = new Adjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POINT, ELEMENTS::FAMILY::POLYHEDRON, source, target, base);
-		auto collectionSize = source->size_all();
-		int nbVertex = 0;
-		int vertexIndex = 0;
-		int PolyhedronIndex = 0;
-		int nval = 0;
-		int nrow = 0;
-
 		auto csr_mat = adj->get_adjacencySparseMatrix();
 
-		csr_mat->rowPtr[0];
+		//Rows of the mesh connectivity are the polyhedra, columns are point local indices
+		const CellConnectivity& connectivity = m_mesh->get_PolyhedronConnectivity();
+		ASSERT(connectivity.size() == source->size_all(), "Polyhedron connectivity is out of sync with the collection");
+		auto collectionSize = connectivity.size();
+		int nval = 0;
+
+		csr_mat->rowPtr.resize(collectionSize + 1);
+		csr_mat->columnIndex.reserve(connectivity.get_vertices().size());
+		csr_mat->values.reserve(connectivity.get_vertices().size());
 		for (size_t i = 0; i != collectionSize; i++)
 		{
-			Polyhedron* polyhedron = source->operator[](static_cast<int>(i));
-			PolyhedronIndex = polyhedron->get_localIndex();
-			const std::vector<Point*>& vertexList = polyhedron->get_vertexList();
-			nbVertex = static_cast<int>(vertexList.size());
-			for (auto j = 0; j < nbVertex; j++)
+			int PolyhedronIndex = static_cast<int>(i);
+			for (auto vertex = connectivity.begin(i); vertex != connectivity.end(i); ++vertex)
 			{
-				vertexIndex = vertexList[j]->get_localIndex();
-				csr_mat->columnIndex.push_back(vertexIndex);
-				csr_mat->values.push_back(PolyhedronIndex);
-				nval++;
+				if (*vertex != CellConnectivity::invalid_index)
+				{
+					csr_mat->columnIndex.push_back(static_cast<int>(*vertex));
+					csr_mat->values.push_back(PolyhedronIndex);
+					nval++;
+				}
 			}
-			nrow++;
-			csr_mat->rowPtr[nrow] = nval;
+			csr_mat->rowPtr[i + 1] = nval;
 		}
 		csr_mat->nnz = nval;
 		csr_mat->sortRowIndexAndMoveValues();
@@ -284,12 +305,41 @@ namespace PAMELA
                 utils::pamela_unused(source);
                 utils::pamela_unused(target);
                 utils::pamela_unused(base);
-		Adjacency* adj1 = get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON);
-		Adjacency* adj2 = get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYHEDRON);
-		Adjacency* adj = Adjacency::multiply(adj1, adj2);
+		//Built from the cells of each face, without going through a matrix product
+		Adjacency* adj = Adjacency::dualGraph(get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYHEDRON));
+		return adj;
+	}
+
+
+	// Polyhedra to Edge adjacency
+	Adjacency* AdjacencySet::get_TopologicalAdjacency(PolyhedronCollection* source, LineCollection* target, PolyhedronCollection* base)
+	{
+		utils::pamela_unused(source);
+		utils::pamela_unused(target);
+		utils::pamela_unused(base);
+		m_mesh->CreateEdgesFromCells();
+		return adjacencyExist(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::LINE, ELEMENTS::FAMILY::POLYHEDRON);
+	}
+
+	Adjacency* AdjacencySet::get_TopologicalAdjacency(LineCollection* source, PolyhedronCollection* target, PolyhedronCollection* base)
+	{
+		utils::pamela_unused(source);
+		utils::pamela_unused(target);
+		utils::pamela_unused(base);
+		Adjacency* adj = Adjacency::transposed(get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::LINE, ELEMENTS::FAMILY::POLYHEDRON));
 		return adj;
 	}
 
+	// Edge to Points adjacency
+	Adjacency* AdjacencySet::get_TopologicalAdjacency(LineCollection* source, PointCollection* target, LineCollection* base)
+	{
+		utils::pamela_unused(source);
+		utils::pamela_unused(target);
+		utils::pamela_unused(base);
+		m_mesh->CreateEdgesFromCells();
+		return adjacencyExist(ELEMENTS::FAMILY::LINE, ELEMENTS::FAMILY::POINT, ELEMENTS::FAMILY::LINE);
+	}
+
 
 	Adjacency* AdjacencySet::adjacencyExist(ELEMENTS::FAMILY source, ELEMENTS::FAMILY target, ELEMENTS::FAMILY base)
 	{
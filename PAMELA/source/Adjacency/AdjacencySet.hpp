@@ -49,11 +49,9 @@ namespace PAMELA
 
 		//General getter
 		Adjacency* get_TopologicalAdjacency(ELEMENTS::FAMILY source, ELEMENTS::FAMILY target, ELEMENTS::FAMILY base);
-		void ClearAfterPartitioning(std::set<int>& PolyhedronOwned, std::set<int>& PolyheronGhost, std::set<int>& PolygonOwned, std::set<int>& PolygonGhost);
-		Adjacency* ClearAfterPartitioning_Topological(Adjacency* adj, std::set<int>& PolygonOwned,
-		                                        std::set<int>& PolygonGhost);
-		Adjacency* ClearAfterPartitioning_NonTopological(Adjacency* adjacency, std::set<int>& Polyhedron_owned,
-		                                                 std::set<int>& Polyhedron_ghost);
+		void ClearAfterPartitioning(const PartitionFilter& PolyhedronFilter, const PartitionFilter& PolygonFilter);
+		Adjacency* ClearAfterPartitioning_Topological(Adjacency* adj, const PartitionFilter& PolygonFilter);
+		Adjacency* ClearAfterPartitioning_NonTopological(Adjacency* adjacency, const PartitionFilter& PolyhedronFilter);
 
 		void Add_NonTopologicalAdjacency(std::string label, Adjacency* adj) { NonTopologicalAdjacencyMap[label] = adj; }
 		void Add_NonTopologicalAdjacencySum(std::string label, std::vector<Adjacency*> sumAdj);
@@ -77,6 +75,9 @@ namespace PAMELA
 		Adjacency* get_TopologicalAdjacency(PolyhedronCollection* source, PolygonCollection* target, PolyhedronCollection* base);
 		Adjacency* get_TopologicalAdjacency(PolygonCollection* source, PolyhedronCollection* target, PolyhedronCollection* base);
 		Adjacency* get_TopologicalAdjacency(PolyhedronCollection* source, PolyhedronCollection* target, PolygonCollection* base);
+		Adjacency* get_TopologicalAdjacency(PolyhedronCollection* source, LineCollection* target, PolyhedronCollection* base);
+		Adjacency* get_TopologicalAdjacency(LineCollection* source, PolyhedronCollection* target, PolyhedronCollection* base);
+		Adjacency* get_TopologicalAdjacency(LineCollection* source, PointCollection* target, LineCollection* base);
 
 
 	};
@@ -14,41 +14,681 @@
 
 #pragma once
 #include <vector>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <utility>
+#include "Utils/Logger.hpp"
+#include "Utils/Assert.hpp"
+#include "Utils/Utils.hpp"
+#include "Utils/ParallelFor.hpp"
 
 namespace PAMELA
 {
 
-	struct CSRMatrix
+	/**
+	 * \brief Compressed sparse row matrix, templated on the type of the row offsets and of the column indices.
+	 * Values hold element indices and use the column index type.
+	 */
+	template <typename OffsetType, typename IndexType>
+	struct CSRMatrixT
 	{
 
-		CSRMatrix(int dim_row, int dim_col, int nn_z) : nnz(nn_z), dimRow(dim_row), dimColumn(dim_col), dimRow_owned(dim_row),
+		typedef OffsetType offset_type;
+		typedef IndexType index_type;
+
+		static_assert(sizeof(offset_type) >= sizeof(index_type), "Offsets must be at least as wide as indices");
+
+		CSRMatrixT(index_type dim_row, index_type dim_col, offset_type nn_z) : nnz(nn_z), dimRow(dim_row), dimColumn(dim_col), dimRow_owned(dim_row),
 		                                               dimColumn_owned(dim_col), dimRow_ghost(0), dimColumn_ghost(0)
 		{
 			values.resize(nnz);
 			rowPtr.resize(dim_row + 1);
 			columnIndex.resize(nnz);
 		}
-		CSRMatrix(int dim_row, int dim_col) :CSRMatrix(dim_row, dim_col, 0) {}
-		CSRMatrix() :CSRMatrix(0, 0, 0) {}
+		CSRMatrixT(index_type dim_row, index_type dim_col) :CSRMatrixT(dim_row, dim_col, 0) {}
+		CSRMatrixT() :CSRMatrixT(0, 0, 0) {}
 
-		static CSRMatrix* transpose(CSRMatrix* matrix);
-		static CSRMatrix* product(CSRMatrix* matrix_lhs, CSRMatrix* matrix_rhs);
-		static CSRMatrix* sum(CSRMatrix* matrix_lhs, CSRMatrix* matrix_rhs);
-		bool checkMatrix();
+		static CSRMatrixT* transpose(const CSRMatrixT* matrix);
+		//Symbolic then numeric pass over the rows in parallel, exact allocation and sorted rows. Inputs may use other offset and index types than the result
+		template <class Lhs, class Rhs>
+		static CSRMatrixT* product(const Lhs* matrix_lhs, const Rhs* matrix_rhs);
+		static CSRMatrixT* sum(const CSRMatrixT* matrix_lhs, const CSRMatrixT* matrix_rhs);
+		//Graph of the columns linked by a row, such as cells sharing a face from face to cell, in linear time.
+		//The value is the linking row, the last one when several rows link the same columns. There are no diagonal entries
+		template <class Matrix>
+		static CSRMatrixT* dualGraph(const Matrix* matrix);
+		bool checkMatrix() const;
 
+		//Sort the columns of the rows in place, values follow. Rows are sorted in parallel, rows already in order are left untouched
 		void sortRowIndexAndMoveValues();
-		void sortRowIndexAndMoveValues(int i);
+		void sortRowIndexAndMoveValues(index_type i);
 		void shrink();
-		void fillEmpty(int dim_row, int dim_col);
+		void fillEmpty(index_type dim_row, index_type dim_col);
+
+
+		offset_type nnz;
+		index_type dimRow, dimColumn;
+		index_type dimRow_owned, dimColumn_owned;
+		index_type dimRow_ghost, dimColumn_ghost;
+		std::vector<offset_type> rowPtr;
+		std::vector<index_type> columnIndex;
+		std::vector<index_type> values;
 
+	private:
 
-		int nnz;
-		int dimRow, dimColumn;
-		int dimRow_owned, dimColumn_owned;
-		int dimRow_ghost, dimColumn_ghost;
-		std::vector<int> rowPtr, columnIndex;
-		std::vector<int> values;
+		//Sorting networks up to 8 entries, insertion sort up to 32, std::sort of the zipped row in scratch beyond
+		void sortRow(offset_type first, offset_type last, std::vector<std::pair<index_type, index_type>>& scratch);
 
 	};
 
+	//Adjacency matrices, 64-bit offsets allow more than 2^31 non-zeros
+	typedef CSRMatrixT<std::int64_t, int> CSRMatrix;
+
+	template <typename OffsetType, typename IndexType>
+	bool CSRMatrixT<OffsetType, IndexType>::checkMatrix() const
+	{
+
+		if (!(dimRow > 0 && dimColumn > 0))
+		{
+			LOGWARNING("The CSR matrix has a zero dimension");
+		}
+
+		offset_type row_start = 0;
+		for (index_type row = 0; row < dimRow - 1; ++row)
+		{
+			if (rowPtr[row] > rowPtr[row + 1])
+			{
+				LOGERROR("The CSR matrix has row pointer decreasing");
+				return false;
+			}
+
+			if (rowPtr[row] == rowPtr[row + 1])
+			{
+				//LOGWARNING("The CSR matrix has an empty row");
+				//return false;
+			}
+
+			offset_type row_stop = rowPtr[row + 1];
+			for (offset_type nnz_index = row_start; nnz_index < row_stop - 1; ++nnz_index)
+			{
+				if (columnIndex[nnz_index] > columnIndex[nnz_index + 1])
+				{
+ 					LOGWARNING("The CSR matrix has a column index vector not sorted");  
+					//return false;
+				}
+				if (columnIndex[nnz_index] == columnIndex[nnz_index + 1])
+				{
+					//LOGWARNING("The CSR matrix has a column values equals in same row");  //TODO:check this. Seems ok.
+					//return false;
+				}
+			}
+			row_start = row_stop;
+		}
+
+		return true;
+	}
+
+	template <typename OffsetType, typename IndexType>
+	void CSRMatrixT<OffsetType, IndexType>::sortRowIndexAndMoveValues()
+	{
+
+		//One scratch per thread, only used by long rows
+		std::vector<std::vector<std::pair<index_type, index_type>>> scratch(utils::get_nbThreads());
+		utils::parallel_for(0, dimRow, [&](std::ptrdiff_t i)
+		{
+			sortRow(rowPtr[i], rowPtr[i + 1], scratch[utils::get_threadIndex()]);
+		});
+
+	}
+
+	template <typename OffsetType, typename IndexType>
+	void CSRMatrixT<OffsetType, IndexType>::sortRowIndexAndMoveValues(index_type i)
+	{
+
+		std::vector<std::pair<index_type, index_type>> scratch;
+		sortRow(rowPtr[i], rowPtr[i + 1], scratch);
+
+	}
+
+	template <typename OffsetType, typename IndexType>
+	void CSRMatrixT<OffsetType, IndexType>::sortRow(offset_type first, offset_type last, std::vector<std::pair<index_type, index_type>>& scratch)
+	{
+
+		index_type* column = columnIndex.data() + first;
+		index_type* value = values.data() + first;
+		const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(last - first);
+
+		//Rows built in order are left untouched
+		std::ptrdiff_t k = 1;
+		while ((k < n) && (column[k - 1] <= column[k]))
+		{
+			++k;
+		}
+		if (k >= n)
+		{
+			return;
+		}
+
+		//Sorting networks for the short rows of mesh adjacencies, network n is made of the pairs [networkBegin[n],networkBegin[n+1])
+		static const unsigned char network[][2] = {
+			{ 0, 1 },
+			{ 1, 2 }, { 0, 2 }, { 0, 1 },
+			{ 0, 1 }, { 2, 3 }, { 0, 2 }, { 1, 3 }, { 1, 2 },
+			{ 0, 1 }, { 3, 4 }, { 2, 4 }, { 2, 3 }, { 0, 3 }, { 0, 2 }, { 1, 4 }, { 1, 3 }, { 1, 2 },
+			{ 1, 2 }, { 4, 5 }, { 0, 2 }, { 3, 5 }, { 0, 1 }, { 3, 4 }, { 1, 4 }, { 0, 3 }, { 2, 5 }, { 1, 3 }, { 2, 4 }, { 2, 3 },
+			{ 1, 2 }, { 3, 4 }, { 5, 6 }, { 0, 2 }, { 3, 5 }, { 4, 6 }, { 0, 1 }, { 4, 5 }, { 2, 6 }, { 0, 4 }, { 1, 5 }, { 0, 3 }, { 2, 5 }, { 1, 3 }, { 2, 4 }, { 2, 3 },
+			{ 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 }, { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 }, { 1, 2 }, { 5, 6 }, { 0, 4 }, { 3, 7 }, { 1, 5 }, { 2, 6 }, { 1, 4 }, { 3, 6 }, { 2, 4 }, { 3, 5 }, { 3, 4 } };
+		static const int networkBegin[10] = { 0, 0, 0, 1, 4, 9, 18, 30, 46, 65 };
+		if (n <= 8)
+		{
+			for (int p = networkBegin[n]; p != networkBegin[n + 1]; ++p)
+			{
+				auto a = network[p][0];
+				auto b = network[p][1];
+				if (column[b] < column[a])
+				{
+					std::swap(column[a], column[b]);
+					std::swap(value[a], value[b]);
+				}
+			}
+		}
+		else if (n <= 32)
+		{
+			//Insertion sort from the first entry out of order
+			for (; k < n; ++k)
+			{
+				auto c = column[k];
+				auto v = value[k];
+				auto j = k;
+				for (; (j > 0) && (column[j - 1] > c); --j)
+				{
+					column[j] = column[j - 1];
+					value[j] = value[j - 1];
+				}
+				column[j] = c;
+				value[j] = v;
+			}
+		}
+		else
+		{
+			scratch.resize(n);
+			for (std::ptrdiff_t j = 0; j < n; ++j)
+			{
+				scratch[j] = std::make_pair(column[j], value[j]);
+			}
+			std::sort(scratch.begin(), scratch.end(),
+				[](const std::pair<index_type, index_type>& a, const std::pair<index_type, index_type>& b)
+			{
+				return a.first < b.first;
+			});
+			for (std::ptrdiff_t j = 0; j < n; ++j)
+			{
+				column[j] = scratch[j].first;
+				value[j] = scratch[j].second;
+			}
+		}
+
+	}
+
+	template <typename OffsetType, typename IndexType>
+	void CSRMatrixT<OffsetType, IndexType>::shrink()
+	{
+		offset_type size = rowPtr[dimRow];
+		values.resize(size);
+		values.shrink_to_fit();
+		columnIndex.resize(size);
+		columnIndex.shrink_to_fit();
+	}
+
+	template <typename OffsetType, typename IndexType>
+	void CSRMatrixT<OffsetType, IndexType>::fillEmpty(index_type dim_row, index_type dim_col)
+	{
+                utils::pamela_unused(dim_col);
+		values.resize(0);
+		rowPtr.resize(dim_row + 1);
+		columnIndex.resize(0);
+	}
+
+	template <typename OffsetType, typename IndexType>
+	template <class Lhs, class Rhs>
+	CSRMatrixT<OffsetType, IndexType>* CSRMatrixT<OffsetType, IndexType>::product(const Lhs* matrix_lhs, const Rhs* matrix_rhs)
+	{
+		ASSERT(matrix_lhs->checkMatrix(), "Problem with CSR matrix data structure");
+		ASSERT(matrix_rhs->checkMatrix(), "Problem with CSR matrix data structure");
+		ASSERT(static_cast<std::int64_t>(matrix_lhs->dimColumn) == static_cast<std::int64_t>(matrix_rhs->dimRow), "Matrix dimensions are not compatible for product operation");
+
+		//Dimensions
+		const index_type Nr = static_cast<index_type>(matrix_lhs->dimRow);
+		const index_type Nc = static_cast<index_type>(matrix_rhs->dimColumn);
+		CSRMatrixT* mult_mat = new CSRMatrixT(Nr, Nc, 0);
+
+		//Work data
+		auto& rowPtr_lhs = matrix_lhs->rowPtr;
+		auto& columnIndex_lhs = matrix_lhs->columnIndex;
+		auto& rowPtr_rhs = matrix_rhs->rowPtr;
+		auto& columnIndex_rhs = matrix_rhs->columnIndex;
+		auto& MrowPtr = mult_mat->rowPtr;
+		auto& McolumnIndex = mult_mat->columnIndex;
+		auto& Mvalues = mult_mat->values;
+
+		//Per thread, last row that reached each column and position of the column in its row
+		const int nThread = utils::get_nbThreads();
+		std::vector<std::vector<index_type>> marker(nThread), position(nThread);
+		auto forEachColumn = [&](index_type ii, auto&& function)
+		{
+			for (auto ka = rowPtr_lhs[ii]; ka < rowPtr_lhs[ii + 1]; ++ka)
+			{
+				auto jj = columnIndex_lhs[ka];
+				for (auto kb = rowPtr_rhs[jj]; kb < rowPtr_rhs[jj + 1]; ++kb)
+				{
+					function(static_cast<index_type>(columnIndex_rhs[kb]), static_cast<index_type>(jj));
+				}
+			}
+		};
+
+		//Symbolic pass: number of columns of each row
+		utils::parallel_for(0, Nr, [&](std::ptrdiff_t i)
+		{
+			auto ii = static_cast<index_type>(i);
+			auto& mark = marker[utils::get_threadIndex()];
+			if (mark.empty())
+			{
+				mark.assign(Nc, -1);
+			}
+			index_type count = 0;
+			forEachColumn(ii, [&](index_type jcol, index_type)
+			{
+				if (mark[jcol] != ii)
+				{
+					mark[jcol] = ii;
+					++count;
+				}
+			});
+			MrowPtr[ii + 1] = count;
+		});
+		for (index_type ii = 0; ii < Nr; ++ii)
+		{
+			MrowPtr[ii + 1] += MrowPtr[ii];
+		}
+		mult_mat->nnz = MrowPtr[Nr];
+		McolumnIndex.resize(mult_mat->nnz);
+		Mvalues.resize(mult_mat->nnz);
+
+		//Numeric pass: columns are gathered and sorted in place, the value is the last intermediate index linking the row and the column, -1 on the diagonal
+		for (auto& mark : marker)
+		{
+			std::fill(mark.begin(), mark.end(), -1);
+		}
+		utils::parallel_for(0, Nr, [&](std::ptrdiff_t i)
+		{
+			auto ii = static_cast<index_type>(i);
+			auto& mark = marker[utils::get_threadIndex()];
+			auto& pos = position[utils::get_threadIndex()];
+			if (mark.empty())
+			{
+				mark.assign(Nc, -1);
+			}
+			if (pos.empty())
+			{
+				pos.resize(Nc);
+			}
+			auto first = McolumnIndex.begin() + MrowPtr[ii];
+			auto last = McolumnIndex.begin() + MrowPtr[ii + 1];
+			auto it = first;
+			forEachColumn(ii, [&](index_type jcol, index_type)
+			{
+				if (mark[jcol] != ii)
+				{
+					mark[jcol] = ii;
+					*it++ = jcol;
+				}
+			});
+			std::sort(first, last);
+			for (auto k = first; k != last; ++k)
+			{
+				pos[*k] = static_cast<index_type>(k - first);
+			}
+			auto values = Mvalues.begin() + MrowPtr[ii];
+			forEachColumn(ii, [&](index_type jcol, index_type jj)
+			{
+				values[pos[jcol]] = (ii == jcol) ? -1 : jj;
+			});
+		});
+
+		ASSERT(mult_mat->checkMatrix(), "Something wrong with the resulting product matrix");
+
+		return mult_mat;
+
+	}
+
+	template <typename OffsetType, typename IndexType>
+	template <class Matrix>
+	CSRMatrixT<OffsetType, IndexType>* CSRMatrixT<OffsetType, IndexType>::dualGraph(const Matrix* matrix)
+	{
+		ASSERT(matrix->checkMatrix(), "Problem with CSR matrix data structure");
+
+		//Dimensions
+		const std::ptrdiff_t Nr = static_cast<std::ptrdiff_t>(matrix->dimRow);
+		const index_type Nc = static_cast<index_type>(matrix->dimColumn);
+		CSRMatrixT* graph = new CSRMatrixT(Nc, Nc, 0);
+
+		//Work data
+		auto& rowPtr = matrix->rowPtr;
+		auto& columnIndex = matrix->columnIndex;
+		auto& GrowPtr = graph->rowPtr;
+		auto& GcolumnIndex = graph->columnIndex;
+		auto& Gvalues = graph->values;
+
+		//Count, a row with k columns gives k-1 entries to each of them
+		for (std::ptrdiff_t row = 0; row < Nr; ++row)
+		{
+			auto k = static_cast<offset_type>(rowPtr[row + 1] - rowPtr[row]);
+			for (auto p = rowPtr[row]; p < rowPtr[row + 1]; ++p)
+			{
+				GrowPtr[columnIndex[p] + 1] += k - 1;
+			}
+		}
+		for (index_type i = 0; i < Nc; ++i)
+		{
+			GrowPtr[i + 1] += GrowPtr[i];
+		}
+		GcolumnIndex.resize(GrowPtr[Nc]);
+		Gvalues.resize(GrowPtr[Nc]);
+
+		//Fill, rows are visited in order so each graph row holds increasing values
+		std::vector<offset_type> cursor(GrowPtr.begin(), GrowPtr.end() - 1);
+		for (std::ptrdiff_t row = 0; row < Nr; ++row)
+		{
+			for (auto p = rowPtr[row]; p < rowPtr[row + 1]; ++p)
+			{
+				for (auto q = rowPtr[row]; q < rowPtr[row + 1]; ++q)
+				{
+					if (p != q)
+					{
+						auto position = cursor[columnIndex[p]]++;
+						GcolumnIndex[position] = static_cast<index_type>(columnIndex[q]);
+						Gvalues[position] = static_cast<index_type>(row);
+					}
+				}
+			}
+		}
+
+		//Sort each row by column, rows are short so a stable insertion sort is used, and keep the last value of repeated columns
+		std::vector<offset_type> length(Nc);
+		utils::parallel_for(0, Nc, [&](std::ptrdiff_t i)
+		{
+			auto first = GrowPtr[i];
+			auto last = GrowPtr[i + 1];
+			for (auto k = first + 1; k < last; ++k)
+			{
+				auto column = GcolumnIndex[k];
+				auto value = Gvalues[k];
+				auto j = k;
+				for (; (j > first) && (GcolumnIndex[j - 1] > column); --j)
+				{
+					GcolumnIndex[j] = GcolumnIndex[j - 1];
+					Gvalues[j] = Gvalues[j - 1];
+				}
+				GcolumnIndex[j] = column;
+				Gvalues[j] = value;
+			}
+			auto n = first;
+			for (auto k = first; k < last; ++k)
+			{
+				if ((n != first) && (GcolumnIndex[n - 1] == GcolumnIndex[k]))
+				{
+					Gvalues[n - 1] = Gvalues[k];
+				}
+				else
+				{
+					GcolumnIndex[n] = GcolumnIndex[k];
+					Gvalues[n++] = Gvalues[k];
+				}
+			}
+			length[i] = n - first;
+		});
+
+		//Compact when columns were linked several times
+		graph->nnz = GrowPtr[Nc];
+		offset_type nnz = 0;
+		for (index_type i = 0; i < Nc; ++i)
+		{
+			nnz += length[i];
+		}
+		if (nnz != graph->nnz)
+		{
+			offset_type position = 0;
+			for (index_type i = 0; i < Nc; ++i)
+			{
+				auto first = GrowPtr[i];
+				std::copy(GcolumnIndex.begin() + first, GcolumnIndex.begin() + first + length[i], GcolumnIndex.begin() + position);
+				std::copy(Gvalues.begin() + first, Gvalues.begin() + first + length[i], Gvalues.begin() + position);
+				GrowPtr[i] = position;
+				position += length[i];
+			}
+			GrowPtr[Nc] = position;
+			graph->nnz = position;
+			graph->shrink();
+		}
+
+		ASSERT(graph->checkMatrix(), "Something wrong with the resulting graph");
+
+		return graph;
+
+	}
+
+	template <typename OffsetType, typename IndexType>
+	CSRMatrixT<OffsetType, IndexType>* CSRMatrixT<OffsetType, IndexType>::sum(const CSRMatrixT* matrix_lhs, const CSRMatrixT* matrix_rhs)
+	{
+
+		ASSERT(matrix_lhs->checkMatrix(), "Problem with CSR matrix data structure");
+		ASSERT(matrix_rhs->checkMatrix(), "Problem with CSR matrix data structure");
+		ASSERT(matrix_lhs->dimColumn == matrix_rhs->dimRow, "Matrix dimensions are not compatible for sum operation");
+
+		//Dimensions
+		offset_type nnz_lhs = matrix_lhs->nnz;
+		index_type Nr_lhs = matrix_lhs->dimRow;
+		offset_type nnz_rhs = matrix_rhs->nnz;
+
+		//Dynamic allocation of trans_mat
+		offset_type nnz_guess = (nnz_lhs + nnz_rhs) * 10;
+		CSRMatrixT* sum_mat = new CSRMatrixT(Nr_lhs, Nr_lhs, nnz_guess);
+
+		index_type MNc = sum_mat->dimColumn;
+
+		//Work data
+		auto& rowPtr_lhs = matrix_lhs->rowPtr;
+		auto& columnIndex_lhs = matrix_lhs->columnIndex;
+		auto& rowPtr_rhs = matrix_rhs->rowPtr;
+		auto& columnIndex_rhs = matrix_rhs->columnIndex;
+		auto& MrowPtr = sum_mat->rowPtr;
+		auto& McolumnIndex = sum_mat->columnIndex;
+		auto& Mvalues = sum_mat->values;
+
+
+		offset_type ka, kb;
+		index_type j1, j2;
+		offset_type kc = 0;
+		offset_type nelea_left, neleb_left;
+		MrowPtr[1] = kc;
+		for (index_type ii = 0; ii < Nr_lhs; ++ii)
+		{
+			ka = rowPtr_lhs[ii];
+			kb = rowPtr_rhs[ii];
+			nelea_left = rowPtr_lhs[ii + 1] - rowPtr_lhs[ii];
+			neleb_left = rowPtr_rhs[ii + 1] - rowPtr_rhs[ii];
+
+
+			if ((nelea_left > 0) || (neleb_left > 0))
+			{
+
+				do
+				{
+
+					if (nelea_left > 0)
+					{
+						j1 = columnIndex_lhs[ka];
+					}
+					else
+					{
+						j1 = MNc;
+					}
+					if (neleb_left > 0)
+					{
+						j2 = columnIndex_rhs[kb];
+					}
+					else
+					{
+						j2 = MNc;
+					}
+
+
+					if (j1 == j2)
+					{
+						Mvalues[kc] = 1;//values_lhs[ka] + values_rhs[kb];
+						McolumnIndex[kc] = j1;
+						ka = ka + 1;
+						kb = kb + 1;
+						kc = kc + 1;
+					}
+					else if (j1 < j2)
+					{
+						McolumnIndex[kc] = j1;
+						Mvalues[kc] = 1;//values_lhs[ka];
+						ka = ka + 1;
+						kc = kc + 1;
+					}
+					else if (j2 < j1)
+					{
+						McolumnIndex[kc] = j2;
+						Mvalues[kc] = 1;//values_lhs[kb];
+						kb = kb + 1;
+						kc = kc + 1;
+					}
+
+					nelea_left = rowPtr_lhs[ii + 1] - ka;
+					neleb_left = rowPtr_rhs[ii + 1] - kb;
+
+				} while ((nelea_left > 0) || (neleb_left > 0));
+
+			}
+			MrowPtr[ii + 1] = kc;
+		}
+
+		//Rows are merged from sorted rows, so they come out sorted
+		sum_mat->shrink();
+		ASSERT(sum_mat->checkMatrix(), "Something wrong with the resulting transposed matrix");
+
+		return sum_mat;
+
+	}
+
+	template <typename OffsetType, typename IndexType>
+	CSRMatrixT<OffsetType, IndexType>* CSRMatrixT<OffsetType, IndexType>::transpose(const CSRMatrixT* matrix)
+	{
+		ASSERT(matrix->checkMatrix(), "Problem with CSR matrix data structure");
+
+		//Dimensions
+		offset_type nnz = matrix->nnz;
+		index_type Nc = matrix->dimColumn;
+		index_type Nr = matrix->dimRow;
+
+		//Dynamic allocation of trans_mat
+		CSRMatrixT* trans_mat = new CSRMatrixT(Nc, Nr, nnz);
+
+		//Work data
+		auto& rowPtr = matrix->rowPtr;
+		auto& columnIndex = matrix->columnIndex;
+		auto& values = matrix->values;
+		auto& TrowPtr = trans_mat->rowPtr;
+		auto& TcolumnIndex = trans_mat->columnIndex;
+		auto& Tvalues = trans_mat->values;
+
+
+		//Small matrices use a serial counting sort. Otherwise all threads count and scatter the entries through atomic column
+		//cursors, which take one offset per column whatever the number of threads
+		const offset_type minParallelSize = 1 << 16;
+
+		if ((utils::get_nbThreads() <= 1) || (nnz < minParallelSize))
+		{
+			//
+			// Stage 1: Compute pattern for B
+			//
+			for (offset_type nnz_index = 0; nnz_index < nnz; ++nnz_index)
+			{
+				++TrowPtr[columnIndex[nnz_index] + 1];
+			}
+			for (index_type row = 0; row < Nc; ++row)
+			{
+				TrowPtr[row + 1] += TrowPtr[row];
+			}
+
+			//
+			// Stage 2: Fill with data
+			//
+			std::vector<offset_type> B_offsets(TrowPtr.begin(), TrowPtr.end() - 1); // index of first unwritten element per row
+			for (index_type row = 0; row < Nr; ++row)
+			{
+				for (offset_type nnz_index = rowPtr[row]; nnz_index < rowPtr[row + 1]; ++nnz_index)
+				{
+					offset_type B_nnz_index = B_offsets[columnIndex[nnz_index]]++;
+					TcolumnIndex[B_nnz_index] = row;
+					Tvalues[B_nnz_index] = values[nnz_index];
+				}
+			}
+		}
+		else
+		{
+			std::vector<std::atomic<offset_type>> cursor(Nc);
+
+			//
+			// Stage 1: Compute pattern for B
+			//
+			utils::parallel_for(0, Nr, [&](std::ptrdiff_t row)
+			{
+				for (offset_type nnz_index = rowPtr[row]; nnz_index < rowPtr[row + 1]; ++nnz_index)
+				{
+					cursor[columnIndex[nnz_index]].fetch_add(1, std::memory_order_relaxed);
+				}
+			});
+
+			// Bring row-start array in place using exclusive-scan:
+			offset_type offset = 0;
+			for (index_type row = 0; row < Nc; ++row)
+			{
+				TrowPtr[row] = offset;
+				offset += cursor[row].load(std::memory_order_relaxed);
+			}
+			TrowPtr[Nc] = offset;
+
+			//
+			// Stage 2: Fill with data
+			//
+			utils::parallel_for(0, Nc, [&](std::ptrdiff_t col)
+			{
+				cursor[col].store(TrowPtr[col], std::memory_order_relaxed);
+			});
+			utils::parallel_for(0, Nr, [&](std::ptrdiff_t row)
+			{
+				for (offset_type nnz_index = rowPtr[row]; nnz_index < rowPtr[row + 1]; ++nnz_index)
+				{
+					offset_type B_nnz_index = cursor[columnIndex[nnz_index]].fetch_add(1, std::memory_order_relaxed);
+					TcolumnIndex[B_nnz_index] = static_cast<index_type>(row);
+					Tvalues[B_nnz_index] = values[nnz_index];
+				}
+			});
+
+			//Rows are filled in thread order, sorting them by source row gives the serial result
+			trans_mat->sortRowIndexAndMoveValues();
+		}
+
+		ASSERT(trans_mat->checkMatrix(), "Something wrong with the resulting transposed matrix");
+
+		return trans_mat;
+
+	}
+
+	extern template struct CSRMatrixT<std::int64_t, int>;
+
 }
@@ -0,0 +1,141 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <limits>
+#include "Elements/Element.hpp"
+#include "Elements/Point.hpp"
+#include "Utils/Assert.hpp"
+
+namespace PAMELA
+{
+
+	/**
+	 * \brief Flat CSR cell-to-vertex connectivity.
+	 * Row i holds the vertices of the i-th element of a collection, as indices in the mesh PointStore, together with its vtk type.
+	 */
+	class CellConnectivity
+	{
+	public:
+
+		typedef std::uint32_t index_type;
+		typedef std::size_t offset_type;
+
+		//Vertex that is not stored on this partition
+		static constexpr index_type invalid_index = std::numeric_limits<index_type>::max();
+
+		CellConnectivity() : m_offsets(1, 0) {}
+
+		void reserve(size_t nCells, size_t nVertices)
+		{
+			m_offsets.reserve(nCells + 1);
+			m_types.reserve(nCells);
+			m_vertices.reserve(nVertices);
+		}
+
+		void clear()
+		{
+			m_offsets.assign(1, 0);
+			m_types.clear();
+			m_vertices.clear();
+		}
+
+		//Add a row
+		void push_back(ELEMENTS::TYPE elementType, const std::vector<Point*>& vertexList)
+		{
+			for (auto point : vertexList)
+			{
+				ASSERT(point->get_store() != nullptr, "Vertex is not stored in the mesh");
+				m_vertices.push_back(static_cast<index_type>(point->get_storeIndex()));
+			}
+			m_offsets.push_back(m_vertices.size());
+			m_types.push_back(elementType);
+		}
+
+		//Add a row from vertex indices in the PointStore
+		void push_back(ELEMENTS::TYPE elementType, const index_type* vertices, size_t nVertex)
+		{
+			m_vertices.insert(m_vertices.end(), vertices, vertices + nVertex);
+			m_offsets.push_back(m_vertices.size());
+			m_types.push_back(elementType);
+		}
+
+		//Getters
+		size_t size() const { return m_types.size(); }
+		ELEMENTS::TYPE get_vtkType(size_t i) const { return m_types[i]; }
+		size_t nVertex(size_t i) const { return m_offsets[i + 1] - m_offsets[i]; }
+		const index_type* begin(size_t i) const { return m_vertices.data() + m_offsets[i]; }
+		const index_type* end(size_t i) const { return m_vertices.data() + m_offsets[i + 1]; }
+
+		const std::vector<offset_type>& get_offsets() const { return m_offsets; }
+		const std::vector<index_type>& get_vertices() const { return m_vertices; }
+		const std::vector<ELEMENTS::TYPE>& get_vtkTypes() const { return m_types; }
+
+		//Rows grouped by vtk type
+		void get_TypeBlocks(std::map<ELEMENTS::TYPE, std::vector<int>>& blocks) const
+		{
+			blocks.clear();
+			for (size_t i = 0; i != m_types.size(); ++i)
+			{
+				blocks[m_types[i]].push_back(static_cast<int>(i));
+			}
+		}
+
+		//Keep only the rows listed in oldRows, in that order
+		void Gather(const std::vector<int>& oldRows)
+		{
+			std::vector<offset_type> offsets; offsets.reserve(oldRows.size() + 1);
+			std::vector<index_type> vertices; vertices.reserve(m_vertices.size());
+			std::vector<ELEMENTS::TYPE> types; types.reserve(oldRows.size());
+			offsets.push_back(0);
+			for (auto row : oldRows)
+			{
+				ASSERT(static_cast<size_t>(row) < size(), "Row out of range");
+				vertices.insert(vertices.end(), begin(row), end(row));
+				offsets.push_back(vertices.size());
+				types.push_back(m_types[row]);
+			}
+			m_offsets.swap(offsets);
+			m_vertices.swap(vertices);
+			m_types.swap(types);
+		}
+
+		//Apply a vertex renumbering, oldToNew holds invalid_index for removed vertices
+		void Renumber(const std::vector<index_type>& oldToNew)
+		{
+			for (auto& vertex : m_vertices)
+			{
+				if (vertex < oldToNew.size())
+				{
+					vertex = oldToNew[vertex];
+				}
+				else
+				{
+					vertex = invalid_index;
+				}
+			}
+		}
+
+	private:
+
+		std::vector<offset_type> m_offsets;
+		std::vector<index_type> m_vertices;
+		std::vector<ELEMENTS::TYPE> m_types;
+
+	};
+
+}
@@ -18,12 +18,15 @@
 #include <map>
 #include <numeric>
 #include <set>
+#include <cstdint>
 #include "Collection/Indexing.hpp"
 #include "Elements/Point.hpp"
 #include "Elements/Line.hpp"
 #include "Elements/Polygon.hpp"
 #include "Elements/Polyhedron.hpp"
+#include "Elements/FaceKey.hpp"
 #include "Collection/ElementEnsemble.hpp"
+#include "Collection/ElementGroup.hpp"
 #include "Utils/Utils.hpp"
 
 namespace PAMELA
@@ -36,28 +39,35 @@ namespace PAMELA
 	{
 		std::size_t operator()(const T& ele) const
 		{
-			auto vect_ver = ele->get_vertexList();
-			int hc = 0;
-			auto length = static_cast<int>(vect_ver.size());
-			for (int i = 0; i < length; i++)
+			//Independent of the vertex order
+			const auto& vect_ver = ele->get_vertexList();
+			std::uint64_t hc = 0;
+			for (auto vertex : vect_ver)
 			{
-				hc += vect_ver[i]->get_localIndex() + i*100000;
+				hc += utils::mixHash(static_cast<std::uint64_t>(vertex->get_localIndex()));
 			}
-			return hc;
+			return static_cast<std::size_t>(utils::mixHash(hc));
 		}
 	};
 
-	//--Point
+	//--Point, duplicated coordinates are merged by the mesh before insertion so points are identified by their address
 	template <>
 	struct ElementHash<Point*>
 	{
 		std::size_t operator()(Point* vec) const
 		{
-			auto coord = vec->get_coordinates();
-			size_t h1 = std::hash<double>()(coord.x);
-			size_t h2 = std::hash<double>()(coord.y);
-			size_t h3 = std::hash<double>()(coord.z);
-			return (h1 ^ (h2 << 1)) ^ h3;
+			return std::hash<Point*>()(vec);
+		}
+	};
+
+
+	//--Polygon
+	template <>
+	struct ElementHash<Polygon*>
+	{
+		std::size_t operator()(Polygon* polygon) const
+		{
+			return FaceKeyHash()(FaceKey(polygon->get_vertexList()));
 		}
 	};
 
@@ -96,9 +106,7 @@ namespace PAMELA
 	{
 		bool operator()(Point* lhs, Point* rhs) const
 		{
-			return	utils::nearlyEqual((lhs)->get_coordinates().x,(rhs)->get_coordinates().x) &&
-				utils::nearlyEqual((lhs)->get_coordinates().y,(rhs)->get_coordinates().y) &&
-				utils::nearlyEqual((lhs)->get_coordinates().z,(rhs)->get_coordinates().z);
+			return lhs == rhs;
 		}
 	};
 
@@ -128,18 +136,7 @@ namespace PAMELA
 	{
 		bool operator()(Polygon* lhs, Polygon* rhs) const
 		{
-			auto lhs_vertex_list = lhs->get_vertexList();
-			auto rhs_vertex_list = rhs->get_vertexList();
-			std::sort(lhs_vertex_list.begin(), lhs_vertex_list.end());
-			std::sort(rhs_vertex_list.begin(), rhs_vertex_list.end());
-			for (size_t i = 0; i < lhs_vertex_list.size(); i++)
-			{
-				if (lhs_vertex_list[i]->get_localIndex() != rhs_vertex_list[i]->get_localIndex())
-				{
-					return false;
-				}
-			}
-			return true;
+			return FaceKey(lhs->get_vertexList()) == FaceKey(rhs->get_vertexList());
 		}
 	};
 
@@ -176,82 +173,138 @@ namespace PAMELA
 	public:
 
 		ElementCollection(ELEMENTS::FAMILY familyType) { m_family = familyType; }
+		ElementCollection(const ElementCollection&) = delete;
+		ElementCollection& operator=(const ElementCollection&) = delete;
+		~ElementCollection()
+		{
+			for (auto group : m_groups)
+			{
+				delete group;
+			}
+		}
 
 		ELEMENTS::FAMILY get_family() const { return m_family; }
 
 		//Add elements
-                std::pair< T, bool > AddElement(std::string label, T cur_element)
+		std::pair< T, bool > AddElement(const std::string& label, T cur_element)
 		{
-			if (!groupExist(label))
+			auto grp = m_groups[get_GroupIndex(label)];
+			auto returnedElement = this->push_back_unique(cur_element);
+			grp->add(returnedElement.first->get_localIndex());
+			return returnedElement;
+		}
+
+		/**
+		 * \brief Add a range of elements to the collection and to one of its groups in a single pass
+		 * Without uniqueness check the caller guarantees that the elements are not in the collection yet, they are then appended without any hash lookup.
+		 * Returns the number of elements added to the collection.
+		 */
+		template <class InputIt>
+		size_t AddElements(int groupIndex, InputIt first, InputIt last, bool checkUnique = true)
+		{
+			ASSERT(static_cast<size_t>(groupIndex) < m_groups.size(), "The group does not exist");
+			auto grp = m_groups[groupIndex];
+			auto nbElements = static_cast<size_t>(std::distance(first, last));
+			this->reserve_unique(this->size_all() + nbElements);
+			grp->reserve(grp->size_all() + nbElements);
+
+			size_t nbAdded = 0;
+			for (; first != last; ++first)
 			{
-				addAndCreateGroup(label);
+				T element = *first;
+				if (checkUnique)
+				{
+					auto returnedElement = this->push_back_unique(element);
+					grp->add(returnedElement.first->get_localIndex());
+					nbAdded += returnedElement.second ? 1 : 0;
+				}
+				else
+				{
+					auto index = static_cast<int>(this->size_all());
+					this->push_back_member(element, false);
+					element->set_localIndex(index);
+					element->set_globalIndex(index);
+					grp->add(index);
+					++nbAdded;
+				}
 			}
-			auto grp = m_labelToGroup[label];
-			grp->push_back_unique(cur_element);
-			auto returnedElement = this->push_back_unique(cur_element);//TODO:index twice
-			return returnedElement;
+			return nbAdded;
 		}
 
+		//Groups record the position of the element in the collection, the local index of a ghost being its rank among the ghosts
+		std::pair< T, bool > AddElement_owned(const std::string& label, T Element)
+		{
+			auto grp = m_groups[get_GroupIndex(label)];
+			auto add = this->push_back_owned_unique(Element);
+			grp->add(this->get_position(add.first));
+			return add;
+		}
 
+		std::pair< T, bool > AddElement_ghost(const std::string& label, T Element)
+		{
+			auto grp = m_groups[get_GroupIndex(label)];
+			auto add = this->push_back_ghost_unique(Element);
+			grp->add(this->get_position(add.first));
+			return add;
+		}
 
-		std::pair< T, bool > AddElement_owned(std::string label, T Element)
+		//Groups
+		void addAndCreateGroup(const std::string& label)
 		{
-			if (!groupExist(label))
+			if (groupExist(label))
 			{
-				addAndCreateGroup(label);
+				return;
 			}
-			auto grp = m_labelToGroup[label];
-			grp->push_back_owned_unique(Element);
-			auto add = push_back_owned_unique(Element);
-			return add;
+			auto group = new ElementGroup<T>(this);
+			m_labelToGroup[label] = group;
+			m_labelToGroupIndex[label] = static_cast<int>(m_groups.size());
+			m_groups.push_back(group);
 		}
-
-		std::pair< T, bool > AddElement_ghost(std::string label, T Element)
+		int get_GroupIndex(const std::string& label)
 		{
-			if (!groupExist(label))
+			auto it = m_labelToGroupIndex.find(label);
+			if (it == m_labelToGroupIndex.end())
 			{
 				addAndCreateGroup(label);
+				return static_cast<int>(m_groups.size()) - 1;
 			}
-			auto grp = m_labelToGroup[label];
-			grp->push_back_ghost_unique(Element);
-			auto add = push_back_ghost_unique(Element);
-			return add;
+			return it->second;
 		}
-
-		//Groups
-		void addAndCreateGroup(std::string label) { m_labelToGroup[label] = new ElementEnsemble<T, ElementHash<T>, ElementEqual<T>>(); }
 		void MakeActiveGroup(std::string label) { ASSERT(groupExist(label), "The group does not exist"); m_activeGroup[label] = true; }
 		std::unordered_map<std::string, bool>& get_ActiveGroupsMap() { return m_activeGroup; }
-		std::unordered_map<std::string, ElementEnsemble<T, ElementHash<T>, ElementEqual<T>>*>& get_labelToGroupMap() { return m_labelToGroup; }
-		ElementEnsemble<T, ElementHash<T>, ElementEqual<T>>* get_Group(std::string label) { ASSERT(groupExist(label), "The group does not exist"); return m_labelToGroup.at(label); }
+		std::unordered_map<std::string, ElementGroup<T>*>& get_labelToGroupMap() { return m_labelToGroup; }
+		ElementGroup<T>* get_Group(const std::string& label) { ASSERT(groupExist(label), "The group does not exist"); return m_labelToGroup.at(label); }
 
 		//Parallel
-		void ClearAfterPartitioning(std::set<int> owned, std::set<int> ghost);
+		void ClearAfterPartitioning(const PartitionFilter& filter);
 
 	protected:
 
 		//Family type
 		ELEMENTS::FAMILY m_family;
 
-		//Groups
-		bool groupExist(std::string label) { return m_labelToGroup.count(label) == 1; }
-		std::unordered_map<std::string, ElementEnsemble<T, ElementHash<T>, ElementEqual<T>>*> m_labelToGroup;
+		//Groups, as local indices in the collection
+		bool groupExist(const std::string& label) { return m_labelToGroup.count(label) == 1; }
+		std::unordered_map<std::string, ElementGroup<T>*> m_labelToGroup;
+		std::unordered_map<std::string, int> m_labelToGroupIndex;
+		std::vector<ElementGroup<T>*> m_groups;
 		std::unordered_map<std::string, bool> m_activeGroup;
 
 	};
 
 	template <class T>
-	void ElementCollection<T>::ClearAfterPartitioning(std::set<int> owned, std::set<int> ghost)
+	void ElementCollection<T>::ClearAfterPartitioning(const PartitionFilter& filter)
 	{
-
-		//Groups
-		for (auto it = m_labelToGroup.begin(); it != m_labelToGroup.end(); ++it)
+		//Groups follow the renumbering, applied while their positions still refer to the former collection
+		auto selection = this->SelectPartition(filter);
+		auto oldToNew = selection.get_oldToNew(this->size_all());
+		for (auto group : m_groups)
 		{
-			it->second->Shrink(owned, ghost);
+			group->Renumber(oldToNew, selection.nOwned);
 		}
 
 		//Collection itself
-		this->Shrink(owned, ghost);
+		this->Gather(selection);
 
 	}
 
@@ -14,9 +14,11 @@
 
 #pragma once
 #include <vector>
-#include <unordered_map>
 #include "Elements/Element.hpp"
 #include "Parallel/ParallelEnsemble.hpp"
+#include "Utils/HashMap.hpp"
+#include "Utils/Utils.hpp"
+#include "Utils/Assert.hpp"
 
 namespace PAMELA
 {
@@ -44,42 +46,16 @@ namespace PAMELA
 		ElementEnsemble() :ParallelEnsemble< T >() {}
 
 
-		//Push back T
-		void push_back_owned(T data)  override
-		{
-                    this->m_data.insert(this->end_owned(), data);
-                    this->Increment_owned();
-		}
-
-		void push_back_ghost(T data)  override
-		{
-			this->m_data.insert(this->end_ghost(), data);
-			this->Increment_ghost();
-		}
-
-		void push_back_owned(std::vector<T> data)  override
-		{
-			this->m_data.insert(this->end_owned(), data.begin(),data.end());
-			this->Increment_owned(data.size());
-		}
-
-		void push_back_ghost(std::vector<T> data)  override
-		{
-			this->m_data.insert(this->end_ghost(), data.begin(), data.end());
-			this->Increment_ghost(data.size());
-		}
-
-
 		//Push_back unique
                 std::pair< T, bool > push_back_owned_unique(T data)
 		{
-			auto index = static_cast<int>(this->end_owned() - this->begin_owned());
+			UpdatePointerMap();
+			auto index = static_cast<int>(this->size_owned());
 			auto insertion = m_pointerToLocalIndex.insert(std::make_pair(data, index));
 			if (insertion.second) //the element is new and the map has been updated
 			{
-				this->m_data.insert(this->end_owned(), data);
+				this->push_back_owned(data);
 				(*data).set_localIndex(index);
-				this->Increment_owned();
 				return std::make_pair( data, true );
 			}
 			return std::make_pair(insertion.first->first, false);
@@ -87,15 +63,13 @@ namespace PAMELA
 
 		std::pair< T, bool > push_back_ghost_unique(T data)
 		{
-			T returned_element = NULL;
-			int index = static_cast<int>(this->end_ghost() - this->begin_ghost());
-			auto insertion = m_pointerToLocalIndex.insert(std::make_pair(data, index));
-			returned_element = insertion.first->first;
+			UpdatePointerMap();
+			int index = static_cast<int>(this->size_ghost());
+			auto insertion = m_pointerToLocalIndex.insert(std::make_pair(data, -index - 1));
 			if (insertion.second) //the element is new and the map has been updated
 			{
-				this->m_data.insert(this->end_ghost(), data);
+				this->push_back_ghost(data);
 				(*data).set_localIndex(index);
-				this->Increment_ghost();
 				//m_elementToLocalIndexMap.insert(std::make_pair(data, index));
 				return std::make_pair( data, true );
 			}
@@ -106,14 +80,14 @@ namespace PAMELA
 
 		std::pair< T, bool > push_back_unique(T data)   //To be use before partitioning
 		{
-			int index = static_cast<int>(this->end() - this->begin());
+			UpdatePointerMap();
+			int index = static_cast<int>(this->size_all());
 			auto insertion = m_pointerToLocalIndex.insert(std::make_pair(data, index));
 			if (insertion.second) //the element is new and the map has been updated
 			{
-				this->m_data.push_back(data);
+				this->push_back_owned(data);
 				(*data).set_localIndex(index);
 				(*data).set_globalIndex(index);
-				this->Increment_all();
 				return std::make_pair( data, true );
 			}
                         //insertion.first->first->set_localIndex(index);
@@ -122,8 +96,50 @@ namespace PAMELA
 		}
 
 
+		//Push back without modifying the indices of the element
+		//Without uniqueness check, the caller guarantees the element is new and the pointer map is rebuilt when next needed
+		bool push_back_member(T data, bool checkUnique = true)
+		{
+			auto index = static_cast<int>(this->size_all());
+			if (checkUnique)
+			{
+				UpdatePointerMap();
+				if (!m_pointerToLocalIndex.insert(std::make_pair(data, index)).second)
+				{
+					return false;
+				}
+			}
+			else
+			{
+				m_pointerMapUpToDate = false;
+			}
+			this->push_back_owned(data);
+			return true;
+		}
+
+		//Reserve storage for n elements
+		void reserve_unique(size_t n)
+		{
+			this->m_data.reserve(n);
+			if (m_pointerMapUpToDate)
+			{
+				m_pointerToLocalIndex.reserve(n);
+			}
+		}
+
+
 		//Getter
-		std::unordered_map<int, int> & get_GlobalToLocalIndex() { return m_GlobalToLocalIndex; }
+		utils::IndexMap& get_GlobalToLocalIndex() { return m_GlobalToLocalIndex; }
+
+		//Position of an element in the ensemble, owned elements first then ghosts
+		int get_position(T data)
+		{
+			UpdatePointerMap();
+			auto it = m_pointerToLocalIndex.find(data);
+			ASSERT(it != m_pointerToLocalIndex.end(), "The element is not in the ensemble");
+			auto value = it->second;
+			return (value >= 0) ? value : static_cast<int>(this->size_owned()) - value - 1;
+		}
 
 
 		//Make Empty
@@ -133,64 +149,89 @@ namespace PAMELA
 			this->m_sizeOwned = 0;
 			this->m_sizeGhost = 0;
 			this->m_data.clear();
+			this->m_pendingOwned.clear();
 			m_pointerToLocalIndex.clear();
+			m_pointerMapUpToDate = true;
+		}
+
+		//Shrink to the elements of a partition, flags are looked up by global index
+		void Shrink(const PartitionFilter& filter, int dimension = 1) override
+		{
+			utils::pamela_unused(dimension);
+			Gather(SelectPartition(filter));
 		}
 
-		//Shrink
-		void Shrink(std::set<int> owned, std::set<int> ghost, int dimension = 1) override
+		PartitionSelection SelectPartition(const PartitionFilter& filter)
 		{
-			//Copy ghost elements amd owned elements in temporary vector
-			std::vector<T> ghost_vec_temp; ghost_vec_temp.reserve(ghost.size() * dimension);
-			std::vector<T> owned_vec_temp; ghost_vec_temp.reserve(owned.size() * dimension);
-			for (auto it = this->m_data.begin(); it != this->m_data.end(); ++it)
+			this->Compact();
+			auto& data = this->m_data;
+			return filter.Select(data.size(), [&data](size_t i) { return data[i]->get_globalIndex(); });
+		}
+
+		//Keep the selected elements, then update ghost flags, numbering and maps
+		void Gather(const PartitionSelection& selection, int dimension = 1) override
+		{
+			utils::pamela_unused(dimension);
+			ParallelEnsemble<T>::Gather(selection);
+
+			auto& data = this->m_data;
+			const size_t nOwned = this->size_owned();
+			std::vector<int> globalIndex(data.size());
+			utils::parallel_for(0, static_cast<std::ptrdiff_t>(data.size()), [&](std::ptrdiff_t i)
 			{
-				if (ghost.count((*it)->get_globalIndex()) == 1)
-				{
-					(*it)->set_IsGhost();
-					ghost_vec_temp.push_back(*it);
-				}
-				else if (owned.count((*it)->get_globalIndex()) == 1)
-				{
-					owned_vec_temp.push_back(*it);
-				}
-				else
+				if (static_cast<size_t>(i) >= nOwned)
 				{
-					//delete *it;  //TODO, need to delete dynamics objects but delete multiple time now. Smart pointer?
-					//*it = nullptr;
+					data[i]->set_IsGhost();
 				}
-			}
+				data[i]->set_localIndex(static_cast<int>(i));
+				globalIndex[i] = data[i]->get_globalIndex();
+			});
 
-			//Rebuilt data
-			this->m_data.clear();
-			this->m_data.reserve(ghost_vec_temp.size() + owned_vec_temp.size());
-			this->m_data.insert(this->m_data.end(), owned_vec_temp.begin(), owned_vec_temp.end());
-			this->m_data.insert(this->m_data.end(), ghost_vec_temp.begin(), ghost_vec_temp.end());
-			this->resize_owned(static_cast<int>(owned_vec_temp.size()));
-			this->resize_ghost(static_cast<int>(ghost_vec_temp.size()));
-
-			//Update Numbering and map
-			int i = 0;
 			m_pointerToLocalIndex.clear();
-			m_GlobalToLocalIndex.clear();
-			for (auto it = this->m_data.begin(); it != this->m_data.end(); ++it)
+			m_pointerToLocalIndex.reserve(data.size());
+			for (size_t i = 0; i != data.size(); ++i)
 			{
-				(*it)->set_localIndex(i);
-				m_pointerToLocalIndex.insert(std::make_pair((*it), static_cast<int>(it - this->m_data.begin())));
-				m_GlobalToLocalIndex.insert(std::make_pair((*it)->get_globalIndex(), static_cast<int>(it - this->m_data.begin())));
-				i++;
+				m_pointerToLocalIndex.insert(std::make_pair(data[i], mapValue(i)));
 			}
+			m_GlobalToLocalIndex.build(globalIndex);
+			m_pointerMapUpToDate = true;
 
 			//Test for emptyness
-			if (this->m_data.size() == 0) MakeEmpty();
+			if (data.empty()) MakeEmpty();
 
 		}
 
 	protected:
 
+		//Rebuild the pointer map after unchecked insertions
+		void UpdatePointerMap()
+		{
+			if (m_pointerMapUpToDate)
+			{
+				return;
+			}
+			this->Compact();
+			m_pointerToLocalIndex.clear();
+			m_pointerToLocalIndex.reserve(this->m_data.size());
+			for (size_t i = 0; i != this->m_data.size(); ++i)
+			{
+				m_pointerToLocalIndex.insert(std::make_pair(this->m_data[i], mapValue(i)));
+			}
+			m_pointerMapUpToDate = true;
+		}
+
+		//Value of the pointer map for the element at position i, ghosts are stored as -1 - rank among the ghosts
+		int mapValue(size_t i) const
+		{
+			return (i < this->size_owned()) ? static_cast<int>(i) : -static_cast<int>(i - this->size_owned()) - 1;
+		}
+
 		//Pointer to Index
-		std::unordered_map<T, int, HashStruct, EqualStruct> m_pointerToLocalIndex;
+		utils::FlatHashMap<T, int, HashStruct, EqualStruct> m_pointerToLocalIndex;
+		bool m_pointerMapUpToDate = true;
 
-		std::unordered_map<int, int> m_GlobalToLocalIndex;
+		//Global to local index, dense when global indices are contiguous
+		utils::IndexMap m_GlobalToLocalIndex;
 
 
 	};
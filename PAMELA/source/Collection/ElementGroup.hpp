@@ -0,0 +1,201 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+#include "Parallel/ParallelEnsemble.hpp"
+#include "Utils/Assert.hpp"
+
+namespace PAMELA
+{
+
+	/**
+	 * \brief Group of elements of a collection, stored as the sorted local indices of its members.
+	 * Owned members come first since owned elements come first in the collection.
+	 */
+	template <class T>
+	class ElementGroup
+	{
+	public:
+
+		class iterator
+		{
+		public:
+
+			typedef std::random_access_iterator_tag iterator_category;
+			typedef T value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef T* pointer;
+			typedef T& reference;
+
+			iterator(ParallelEnsemble<T>* parent, std::vector<int>::const_iterator index) : m_parent(parent), m_index(index) {}
+
+			T& operator*() const { return (*m_parent)[*m_index]; }
+			iterator& operator++() { ++m_index; return *this; }
+			iterator operator++(int) { iterator it(*this); ++m_index; return it; }
+			iterator& operator--() { --m_index; return *this; }
+			iterator& operator+=(difference_type n) { m_index += n; return *this; }
+			iterator operator+(difference_type n) const { return iterator(m_parent, m_index + n); }
+			difference_type operator-(const iterator& rhs) const { return m_index - rhs.m_index; }
+			bool operator==(const iterator& rhs) const { return m_index == rhs.m_index; }
+			bool operator!=(const iterator& rhs) const { return m_index != rhs.m_index; }
+
+			//Index of the element in the collection
+			int index() const { return *m_index; }
+
+		private:
+
+			ParallelEnsemble<T>* m_parent;
+			std::vector<int>::const_iterator m_index;
+
+		};
+
+		explicit ElementGroup(ParallelEnsemble<T>* parent) : m_parent(parent) {}
+
+		//Add the element at the given position of the collection, positions past the owned elements are ghosts
+		//Ghosts are kept by rank among the ghosts, so that owned elements added later do not shift them
+		void add(int index)
+		{
+			auto nOwned = static_cast<int>(m_parent->size_owned());
+			if (index < nOwned)
+			{
+				append(m_owned, m_ownedSorted, index);
+			}
+			else
+			{
+				append(m_ghosts, m_ghostsSorted, index - nOwned);
+			}
+			m_upToDate = false;
+		}
+
+		void reserve(size_t n) { m_owned.reserve(n); }
+
+		//Membership
+		bool contains(int index) { sort(); return std::binary_search(m_indices.begin(), m_indices.end(), index); }
+
+		//Sizes
+		size_t size_all() { sort(); return m_indices.size(); }
+		size_t size_owned() { sort(); return m_owned.size(); }
+		size_t size_ghost() { return size_all() - size_owned(); }
+
+		//Iterators
+		iterator begin() { sort(); return iterator(m_parent, m_indices.cbegin()); }
+		iterator end() { sort(); return iterator(m_parent, m_indices.cend()); }
+		iterator begin_owned() { return begin(); }
+		iterator end_owned() { return begin() + static_cast<std::ptrdiff_t>(size_owned()); }
+		iterator begin_ghost() { return end_owned(); }
+		iterator end_ghost() { return end(); }
+
+		T& operator[](size_t i) { sort(); return (*m_parent)[m_indices[i]]; }
+		const std::vector<int>& get_indices() { sort(); return m_indices; }
+
+		//Apply a renumbering of the collection, oldToNew holds -1 for removed elements
+		//Called before the collection is resized, nOwned is its new number of owned elements
+		void Renumber(const std::vector<int>& oldToNew, size_t nOwned)
+		{
+			sort();
+			m_owned.clear();
+			m_ghosts.clear();
+			for (auto index : m_indices)
+			{
+				auto newIndex = oldToNew[index];
+				if (newIndex == -1)
+				{
+					continue;
+				}
+				if (newIndex < static_cast<int>(nOwned))
+				{
+					m_owned.push_back(newIndex);
+				}
+				else
+				{
+					m_ghosts.push_back(newIndex - static_cast<int>(nOwned));
+				}
+			}
+			m_ownedSorted = false;
+			m_ghostsSorted = false;
+			m_upToDate = false;
+		}
+
+		void clear()
+		{
+			m_owned.clear();
+			m_ghosts.clear();
+			m_indices.clear();
+			m_ownedSorted = true;
+			m_ghostsSorted = true;
+			m_upToDate = true;
+			m_nOwned = m_parent->size_owned();
+		}
+
+	private:
+
+		static void append(std::vector<int>& indices, bool& sorted, int index)
+		{
+			if (indices.empty() || (index > indices.back()))
+			{
+				indices.push_back(index);
+			}
+			else if (index != indices.back())
+			{
+				indices.push_back(index);
+				sorted = false;
+			}
+		}
+
+		static void sort(std::vector<int>& indices, bool& sorted)
+		{
+			if (!sorted)
+			{
+				std::sort(indices.begin(), indices.end());
+				indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+				sorted = true;
+			}
+		}
+
+		//Positions in the collection, owned members then ghosts placed after the current owned elements
+		void sort()
+		{
+			if (m_upToDate && (m_nOwned == m_parent->size_owned()))
+			{
+				return;
+			}
+			sort(m_owned, m_ownedSorted);
+			sort(m_ghosts, m_ghostsSorted);
+			m_nOwned = m_parent->size_owned();
+			m_indices.assign(m_owned.begin(), m_owned.end());
+			for (auto rank : m_ghosts)
+			{
+				m_indices.push_back(static_cast<int>(m_nOwned) + rank);
+			}
+			m_upToDate = true;
+		}
+
+		ParallelEnsemble<T>* m_parent;
+		std::vector<int> m_owned;
+		std::vector<int> m_ghosts;
+		bool m_ownedSorted = true;
+		bool m_ghostsSorted = true;
+
+		//Cached positions, rebuilt after additions or when the number of owned elements of the collection changed
+		std::vector<int> m_indices;
+		size_t m_nOwned = 0;
+		bool m_upToDate = true;
+
+	};
+
+}
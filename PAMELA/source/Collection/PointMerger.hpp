@@ -0,0 +1,169 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include "Collection/PointStore.hpp"
+#include "Utils/HashMap.hpp"
+
+namespace PAMELA
+{
+
+	/**
+	 * \brief Tolerance-aware lookup of the points of a PointStore.
+	 * Points are binned in a uniform grid of cells larger than the tolerance, two points are merged when all their coordinates differ by less than the tolerance.
+	 * A query visits the cell of the point and the neighbouring cells closer than the tolerance, at most 8 cells.
+	 * When several stored points match, the first inserted one is returned so that results do not depend on the hash order.
+	 */
+	class PointMerger
+	{
+	public:
+
+		explicit PointMerger(double tolerance = 1e-6) : m_tolerance(tolerance), m_cellSize(4 * tolerance) {}
+
+		void clear() { m_cells.clear(); m_next.clear(); }
+		void reserve(size_t n) { m_cells.reserve(n); m_next.reserve(n); }
+
+		//Index all points of the store
+		void rebuild(const PointStore& store)
+		{
+			clear();
+			reserve(store.size());
+			for (size_t i = 0; i != store.size(); ++i)
+			{
+				insert(store, static_cast<PointHandle>(i));
+			}
+		}
+
+		//Index a point of the store
+		void insert(const PointStore& store, PointHandle handle)
+		{
+			if (static_cast<size_t>(handle) >= m_next.size())
+			{
+				m_next.resize(handle + 1, -1);
+			}
+			auto insertion = m_cells.insert(std::make_pair(cellOf(store.x(handle), store.y(handle), store.z(handle)), handle));
+			if (!insertion.second)
+			{
+				m_next[handle] = insertion.first->second;
+				insertion.first->second = handle;
+			}
+		}
+
+		//First indexed point within tolerance, -1 if none
+		PointHandle find(const PointStore& store, double x, double y, double z) const
+		{
+			CellKey cell = cellOf(x, y, z);
+			std::int64_t neighbour[3];
+			neighbour[0] = neighbourOf(x, cell.i[0]);
+			neighbour[1] = neighbourOf(y, cell.i[1]);
+			neighbour[2] = neighbourOf(z, cell.i[2]);
+
+			PointHandle found = -1;
+			for (int n = 0; n != 8; ++n)
+			{
+				CellKey key = cell;
+				bool skip = false;
+				for (int d = 0; d != 3; ++d)
+				{
+					if (n & (1 << d))
+					{
+						skip = skip || (neighbour[d] == cell.i[d]);
+						key.i[d] = neighbour[d];
+					}
+				}
+				if (skip)
+				{
+					continue;
+				}
+				auto it = m_cells.find(key);
+				if (it == m_cells.end())
+				{
+					continue;
+				}
+				for (auto handle = it->second; handle != -1; handle = m_next[handle])
+				{
+					if ((std::fabs(store.x(handle) - x) < m_tolerance) && (std::fabs(store.y(handle) - y) < m_tolerance) && (std::fabs(store.z(handle) - z) < m_tolerance))
+					{
+						found = (found == -1) ? handle : std::min(found, handle);
+					}
+				}
+			}
+			return found;
+		}
+
+		//Getters
+		double get_tolerance() const { return m_tolerance; }
+
+	private:
+
+		struct CellKey
+		{
+			std::int64_t i[3];
+			bool operator==(const CellKey& rhs) const { return (i[0] == rhs.i[0]) && (i[1] == rhs.i[1]) && (i[2] == rhs.i[2]); }
+		};
+
+		struct CellKeyHash
+		{
+			std::size_t operator()(const CellKey& key) const
+			{
+				auto h = utils::mixHash(static_cast<std::uint64_t>(key.i[0]));
+				h = utils::mixHash(h ^ static_cast<std::uint64_t>(key.i[1]));
+				h = utils::mixHash(h ^ static_cast<std::uint64_t>(key.i[2]));
+				return static_cast<std::size_t>(h);
+			}
+		};
+
+		std::int64_t indexOf(double x) const
+		{
+			const double limit = 4e18;
+			//Grid shifted by half a cell so that round coordinates do not fall on cell boundaries
+			double i = std::floor(x / m_cellSize + 0.5);
+			return static_cast<std::int64_t>(std::max(-limit, std::min(limit, i)));
+		}
+
+		CellKey cellOf(double x, double y, double z) const
+		{
+			CellKey key;
+			key.i[0] = indexOf(x);
+			key.i[1] = indexOf(y);
+			key.i[2] = indexOf(z);
+			return key;
+		}
+
+		//Neighbouring cell that can hold a point within tolerance, the cell itself if none
+		std::int64_t neighbourOf(double x, std::int64_t i) const
+		{
+			if (indexOf(x - m_tolerance) != i)
+			{
+				return i - 1;
+			}
+			if (indexOf(x + m_tolerance) != i)
+			{
+				return i + 1;
+			}
+			return i;
+		}
+
+		double m_tolerance;
+		double m_cellSize;
+		utils::FlatHashMap<CellKey, PointHandle, CellKeyHash> m_cells;
+		std::vector<PointHandle> m_next;
+
+	};
+
+}
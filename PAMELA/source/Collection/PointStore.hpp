@@ -0,0 +1,116 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "Utils/SimpleMaths.hpp"
+#include "Utils/Assert.hpp"
+
+namespace PAMELA
+{
+
+	//Index of a point inside a PointStore
+	typedef int PointHandle;
+
+	/**
+	 * \brief Structure-of-arrays storage of point coordinates.
+	 * Coordinates are kept in three contiguous arrays so that geometry loops, partitioners and writers can stream them.
+	 */
+	class PointStore
+	{
+	public:
+
+		PointStore() = default;
+
+		//Add
+		PointHandle push_back(double x, double y, double z)
+		{
+			m_x.push_back(x);
+			m_y.push_back(y);
+			m_z.push_back(z);
+			return static_cast<PointHandle>(m_x.size() - 1);
+		}
+
+		PointHandle push_back(const Coordinates& coord) { return push_back(coord.x, coord.y, coord.z); }
+
+		void reserve(size_t n) { m_x.reserve(n); m_y.reserve(n); m_z.reserve(n); }
+		void clear() { m_x.clear(); m_y.clear(); m_z.clear(); }
+
+		//Getters
+		size_t size() const { return m_x.size(); }
+
+		double x(PointHandle i) const { return m_x[i]; }
+		double y(PointHandle i) const { return m_y[i]; }
+		double z(PointHandle i) const { return m_z[i]; }
+
+		Coordinates get_coordinates(PointHandle i) const { return Coordinates(m_x[i], m_y[i], m_z[i]); }
+
+		const std::vector<double>& get_x() const { return m_x; }
+		const std::vector<double>& get_y() const { return m_y; }
+		const std::vector<double>& get_z() const { return m_z; }
+
+		//Setters
+		void set_coordinates(PointHandle i, double x, double y, double z) { m_x[i] = x; m_y[i] = y; m_z[i] = z; }
+		void set_coordinates(PointHandle i, const Coordinates& coord) { set_coordinates(i, coord.x, coord.y, coord.z); }
+
+		//Bounding box of all stored points
+		void get_BoundingBox(Coordinates& min, Coordinates& max) const
+		{
+			min = Coordinates(std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+			max = Coordinates(std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest());
+			const size_t n = m_x.size();
+			for (size_t i = 0; i < n; ++i)
+			{
+				min.x = std::min(min.x, m_x[i]);
+				max.x = std::max(max.x, m_x[i]);
+			}
+			for (size_t i = 0; i < n; ++i)
+			{
+				min.y = std::min(min.y, m_y[i]);
+				max.y = std::max(max.y, m_y[i]);
+			}
+			for (size_t i = 0; i < n; ++i)
+			{
+				min.z = std::min(min.z, m_z[i]);
+				max.z = std::max(max.z, m_z[i]);
+			}
+		}
+
+		//Keep only the points listed in oldIndex, in that order
+		void Gather(const std::vector<PointHandle>& oldIndex)
+		{
+			std::vector<double> x(oldIndex.size()), y(oldIndex.size()), z(oldIndex.size());
+			for (size_t i = 0; i < oldIndex.size(); ++i)
+			{
+				ASSERT(static_cast<size_t>(oldIndex[i]) < m_x.size(), "Point handle out of range");
+				x[i] = m_x[oldIndex[i]];
+				y[i] = m_y[oldIndex[i]];
+				z[i] = m_z[oldIndex[i]];
+			}
+			m_x.swap(x);
+			m_y.swap(y);
+			m_z.swap(z);
+		}
+
+	private:
+
+		std::vector<double> m_x;
+		std::vector<double> m_y;
+		std::vector<double> m_z;
+
+	};
+
+}
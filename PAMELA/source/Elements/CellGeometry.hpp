@@ -0,0 +1,548 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <vector>
+#include <map>
+#include <cmath>
+#include <algorithm>
+#include "Elements/Element.hpp"
+#include "Elements/Polygon.hpp"
+#include "Elements/Polyhedron.hpp"
+#include "Collection/PointStore.hpp"
+#include "Collection/CellConnectivity.hpp"
+#include "Utils/Assert.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/ParallelFor.hpp"
+
+namespace PAMELA
+{
+
+	/**
+	 * \brief Volumes, centroids and bounding boxes of cells, stored as arrays indexed by the cell local index
+	 */
+	struct CellGeometry
+	{
+		std::vector<double> volume;
+		std::vector<double> x;
+		std::vector<double> y;
+		std::vector<double> z;
+
+		//Bounding boxes
+		std::vector<double> xmin, ymin, zmin;
+		std::vector<double> xmax, ymax, zmax;
+
+		void resize(size_t n)
+		{
+			volume.resize(n, 0); x.resize(n, 0); y.resize(n, 0); z.resize(n, 0);
+			xmin.resize(n, 0); ymin.resize(n, 0); zmin.resize(n, 0);
+			xmax.resize(n, 0); ymax.resize(n, 0); zmax.resize(n, 0);
+		}
+		void clear()
+		{
+			volume.clear(); x.clear(); y.clear(); z.clear();
+			xmin.clear(); ymin.clear(); zmin.clear();
+			xmax.clear(); ymax.clear(); zmax.clear();
+		}
+		size_t size() const { return volume.size(); }
+
+		Coordinates get_centroid(size_t i) const { return Coordinates(x[i], y[i], z[i]); }
+	};
+
+	/**
+	 * \brief Areas, unit normals and centroids of faces, stored as arrays indexed by the face local index
+	 */
+	struct FaceGeometry
+	{
+		std::vector<double> area;
+		std::vector<double> nx, ny, nz;
+		std::vector<double> x, y, z;
+
+		void resize(size_t n)
+		{
+			area.resize(n, 0);
+			nx.resize(n, 0); ny.resize(n, 0); nz.resize(n, 0);
+			x.resize(n, 0); y.resize(n, 0); z.resize(n, 0);
+		}
+		void clear()
+		{
+			area.clear();
+			nx.clear(); ny.clear(); nz.clear();
+			x.clear(); y.clear(); z.clear();
+		}
+		size_t size() const { return area.size(); }
+
+		Coordinates get_centroid(size_t i) const { return Coordinates(x[i], y[i], z[i]); }
+		Vec3 get_normal(size_t i) const { return Vec3(nx[i], ny[i], nz[i]); }
+	};
+
+	///Batch geometry kernels
+	//Cells of one type are processed by tiles: vertex coordinates of a tile are gathered in small local arrays,
+	//then each quantity is computed by a loop over the cells of the tile that the compiler can vectorize.
+	namespace GEOMETRY
+	{
+
+		constexpr int TileWidth = 8;
+
+		//Vertex coordinates of a tile of cells, padded with degenerated cells
+		template <int nVertex>
+		struct CellTile
+		{
+			double x[nVertex][TileWidth];
+			double y[nVertex][TileWidth];
+			double z[nVertex][TileWidth];
+			int size;
+
+			//vertexCoordinates(cell, ivertex, x, y, z)
+			template <class VertexCoordinates>
+			void Gather(const int* cells, int nCells, VertexCoordinates& vertexCoordinates)
+			{
+				size = nCells;
+				for (int c = 0; c != TileWidth; ++c)
+				{
+					for (int j = 0; j != nVertex; ++j)
+					{
+						if (c < nCells)
+						{
+							vertexCoordinates(cells[c], j, x[j][c], y[j][c], z[j][c]);
+						}
+						else
+						{
+							x[j][c] = 0; y[j][c] = 0; z[j][c] = 0;
+						}
+					}
+				}
+			}
+		};
+
+		//Signed volume (times 6) and centroid of the tetrahedra (a,b,c,d) of a tile, accumulated in sums
+		template <int nVertex>
+		inline void AccumulateTetrahedra(const CellTile<nVertex>& tile, int a, int b, int c, int d,
+			double* volume, double* x, double* y, double* z)
+		{
+			for (int k = 0; k < TileWidth; ++k)
+			{
+				const double e1x = tile.x[b][k] - tile.x[a][k], e1y = tile.y[b][k] - tile.y[a][k], e1z = tile.z[b][k] - tile.z[a][k];
+				const double e2x = tile.x[c][k] - tile.x[a][k], e2y = tile.y[c][k] - tile.y[a][k], e2z = tile.z[c][k] - tile.z[a][k];
+				const double e3x = tile.x[d][k] - tile.x[a][k], e3y = tile.y[d][k] - tile.y[a][k], e3z = tile.z[d][k] - tile.z[a][k];
+				const double det = e1x * (e2y * e3z - e3y * e2z) - e2x * (e1y * e3z - e3y * e1z) + e3x * (e1y * e2z - e2y * e1z);
+				volume[k] += det;
+				x[k] += det * 0.25 * (tile.x[a][k] + tile.x[b][k] + tile.x[c][k] + tile.x[d][k]);
+				y[k] += det * 0.25 * (tile.y[a][k] + tile.y[b][k] + tile.y[c][k] + tile.y[d][k]);
+				z[k] += det * 0.25 * (tile.z[a][k] + tile.z[b][k] + tile.z[c][k] + tile.z[d][k]);
+			}
+		}
+
+		//Volumes and centroids of a tile, written in local arrays
+		template <ELEMENTS::TYPE elementType>
+		struct TileKernel;
+
+		template <>
+		struct TileKernel<ELEMENTS::TYPE::VTK_TETRA>
+		{
+			static void Compute(const CellTile<4>& tile, double* volume, double* x, double* y, double* z)
+			{
+				std::fill(volume, volume + TileWidth, 0.);
+				std::fill(x, x + TileWidth, 0.); std::fill(y, y + TileWidth, 0.); std::fill(z, z + TileWidth, 0.);
+				AccumulateTetrahedra(tile, 0, 1, 2, 3, volume, x, y, z);
+				for (int k = 0; k < TileWidth; ++k)
+				{
+					const double inv = (volume[k] != 0) ? 1. / volume[k] : 0.;
+					x[k] *= inv; y[k] *= inv; z[k] *= inv;
+					volume[k] = std::fabs(volume[k]) / 6.;
+				}
+			}
+		};
+
+		//Trilinear mapping, integrated with the same 2x2x2 Gauss rule as the element (exact for the trilinear Jacobian).
+		//The centroid is the image of the reference center, as for the element.
+		template <>
+		struct TileKernel<ELEMENTS::TYPE::VTK_HEXAHEDRON>
+		{
+			struct Quadrature
+			{
+				//Shape function derivatives at the Gauss points
+				double dN[8][8][3];
+
+				Quadrature()
+				{
+					const double alpha = 1. / std::sqrt(3.);
+					const double xi[8][3] = { { -1, -1, -1 },{ 1, -1, -1 },{ 1, 1, -1 },{ -1, 1, -1 },{ -1, -1, 1 },{ 1, -1, 1 },{ 1, 1, 1 },{ -1, 1, 1 } };
+					for (int g = 0; g != 8; ++g)
+					{
+						auto derivatives = ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_HEXAHEDRON>::get_BasisFunctionDerivatives(alpha * xi[g][0], alpha * xi[g][1], alpha * xi[g][2]);
+						for (int j = 0; j != 8; ++j)
+						{
+							dN[g][j][0] = derivatives[j][0];
+							dN[g][j][1] = derivatives[j][1];
+							dN[g][j][2] = derivatives[j][2];
+						}
+					}
+				}
+			};
+
+			static void Compute(const CellTile<8>& tile, double* volume, double* x, double* y, double* z)
+			{
+				static const Quadrature quadrature;
+				std::fill(volume, volume + TileWidth, 0.);
+				for (int g = 0; g != 8; ++g)
+				{
+					double J[3][3][TileWidth];
+					for (int r = 0; r != 3; ++r)
+					{
+						for (int s = 0; s != 3; ++s)
+						{
+							std::fill(J[r][s], J[r][s] + TileWidth, 0.);
+						}
+					}
+					for (int j = 0; j != 8; ++j)
+					{
+						for (int s = 0; s != 3; ++s)
+						{
+							const double dN = quadrature.dN[g][j][s];
+							for (int k = 0; k < TileWidth; ++k)
+							{
+								J[0][s][k] += tile.x[j][k] * dN;
+								J[1][s][k] += tile.y[j][k] * dN;
+								J[2][s][k] += tile.z[j][k] * dN;
+							}
+						}
+					}
+					for (int k = 0; k < TileWidth; ++k)
+					{
+						volume[k] += J[0][0][k] * (J[1][1][k] * J[2][2][k] - J[2][1][k] * J[1][2][k])
+							- J[0][1][k] * (J[1][0][k] * J[2][2][k] - J[2][0][k] * J[1][2][k])
+							+ J[0][2][k] * (J[1][0][k] * J[2][1][k] - J[2][0][k] * J[1][1][k]);
+					}
+				}
+				for (int k = 0; k < TileWidth; ++k)
+				{
+					volume[k] = std::fabs(volume[k]);
+					double sx = 0, sy = 0, sz = 0;
+					for (int j = 0; j != 8; ++j)
+					{
+						sx += tile.x[j][k]; sy += tile.y[j][k]; sz += tile.z[j][k];
+					}
+					x[k] = sx / 8.; y[k] = sy / 8.; z[k] = sz / 8.;
+				}
+			}
+		};
+
+		//Split in 3 tetrahedra
+		template <>
+		struct TileKernel<ELEMENTS::TYPE::VTK_WEDGE>
+		{
+			static void Compute(const CellTile<6>& tile, double* volume, double* x, double* y, double* z)
+			{
+				std::fill(volume, volume + TileWidth, 0.);
+				std::fill(x, x + TileWidth, 0.); std::fill(y, y + TileWidth, 0.); std::fill(z, z + TileWidth, 0.);
+				AccumulateTetrahedra(tile, 0, 1, 2, 5, volume, x, y, z);
+				AccumulateTetrahedra(tile, 0, 1, 5, 4, volume, x, y, z);
+				AccumulateTetrahedra(tile, 0, 4, 5, 3, volume, x, y, z);
+				for (int k = 0; k < TileWidth; ++k)
+				{
+					const double inv = (volume[k] != 0) ? 1. / volume[k] : 0.;
+					x[k] *= inv; y[k] *= inv; z[k] *= inv;
+					volume[k] = std::fabs(volume[k]) / 6.;
+				}
+			}
+		};
+
+		//Split in 2 tetrahedra
+		template <>
+		struct TileKernel<ELEMENTS::TYPE::VTK_PYRAMID>
+		{
+			static void Compute(const CellTile<5>& tile, double* volume, double* x, double* y, double* z)
+			{
+				std::fill(volume, volume + TileWidth, 0.);
+				std::fill(x, x + TileWidth, 0.); std::fill(y, y + TileWidth, 0.); std::fill(z, z + TileWidth, 0.);
+				AccumulateTetrahedra(tile, 0, 1, 2, 4, volume, x, y, z);
+				AccumulateTetrahedra(tile, 0, 2, 3, 4, volume, x, y, z);
+				for (int k = 0; k < TileWidth; ++k)
+				{
+					const double inv = (volume[k] != 0) ? 1. / volume[k] : 0.;
+					x[k] *= inv; y[k] *= inv; z[k] *= inv;
+					volume[k] = std::fabs(volume[k]) / 6.;
+				}
+			}
+		};
+
+		/**
+		 * \brief Compute volumes, centroids and bounding boxes of cells of one type, tiles are shared among threads
+		 * \param cells local indices of the cells, results are written at these positions
+		 * \param vertexCoordinates functor (cell, ivertex, x, y, z) giving the coordinates of a vertex
+		 */
+		template <ELEMENTS::TYPE elementType, class VertexCoordinates>
+		void ComputeVolumesAndCentroids(const std::vector<int>& cells, VertexCoordinates&& vertexCoordinates, CellGeometry& geometry)
+		{
+			constexpr int nVertex = ELEMENTS::TypeTraits<elementType>::nVertex();
+			const int nCells = static_cast<int>(cells.size());
+			const int nTiles = (nCells + TileWidth - 1) / TileWidth;
+			utils::parallel_for(0, nTiles, [&](std::ptrdiff_t itile)
+			{
+				CellTile<nVertex> tile;
+				double volume[TileWidth], x[TileWidth], y[TileWidth], z[TileWidth];
+				const int start = static_cast<int>(itile) * TileWidth;
+				const int n = std::min(TileWidth, nCells - start);
+				tile.Gather(cells.data() + start, n, vertexCoordinates);
+				TileKernel<elementType>::Compute(tile, volume, x, y, z);
+				for (int k = 0; k < n; ++k)
+				{
+					const auto cell = cells[start + k];
+					geometry.volume[cell] = volume[k];
+					geometry.x[cell] = x[k];
+					geometry.y[cell] = y[k];
+					geometry.z[cell] = z[k];
+					double bmin[3] = { tile.x[0][k], tile.y[0][k], tile.z[0][k] };
+					double bmax[3] = { tile.x[0][k], tile.y[0][k], tile.z[0][k] };
+					for (int j = 1; j != nVertex; ++j)
+					{
+						bmin[0] = std::min(bmin[0], tile.x[j][k]); bmax[0] = std::max(bmax[0], tile.x[j][k]);
+						bmin[1] = std::min(bmin[1], tile.y[j][k]); bmax[1] = std::max(bmax[1], tile.y[j][k]);
+						bmin[2] = std::min(bmin[2], tile.z[j][k]); bmax[2] = std::max(bmax[2], tile.z[j][k]);
+					}
+					geometry.xmin[cell] = bmin[0]; geometry.ymin[cell] = bmin[1]; geometry.zmin[cell] = bmin[2];
+					geometry.xmax[cell] = bmax[0]; geometry.ymax[cell] = bmax[1]; geometry.zmax[cell] = bmax[2];
+				}
+			});
+		}
+
+		//Coordinates read through a connectivity, all vertices must be in the store
+		template <ELEMENTS::TYPE elementType>
+		void ComputeVolumesAndCentroids(const std::vector<int>& cells, const PointStore& points, const CellConnectivity& connectivity, CellGeometry& geometry)
+		{
+			auto& px = points.get_x();
+			auto& py = points.get_y();
+			auto& pz = points.get_z();
+			ComputeVolumesAndCentroids<elementType>(cells, [&](int cell, int j, double& x, double& y, double& z)
+			{
+				auto vertex = connectivity.begin(cell)[j];
+				ASSERT(vertex < points.size(), "Vertex is not in the point store");
+				x = px[vertex]; y = py[vertex]; z = pz[vertex];
+			}, geometry);
+		}
+
+		/**
+		 * \brief Compute volumes and centroids of all cells of a connectivity, type by type
+		 * \param blocks local indices of the cells per type
+		 */
+		template <class VertexCoordinates>
+		void ComputeVolumesAndCentroids(const std::map<ELEMENTS::TYPE, std::vector<int>>& blocks, VertexCoordinates&& vertexCoordinates, CellGeometry& geometry)
+		{
+			for (auto& block : blocks)
+			{
+				switch (block.first)
+				{
+				case ELEMENTS::TYPE::VTK_TETRA:
+					ComputeVolumesAndCentroids<ELEMENTS::TYPE::VTK_TETRA>(block.second, vertexCoordinates, geometry);
+					break;
+				case ELEMENTS::TYPE::VTK_HEXAHEDRON:
+					ComputeVolumesAndCentroids<ELEMENTS::TYPE::VTK_HEXAHEDRON>(block.second, vertexCoordinates, geometry);
+					break;
+				case ELEMENTS::TYPE::VTK_WEDGE:
+					ComputeVolumesAndCentroids<ELEMENTS::TYPE::VTK_WEDGE>(block.second, vertexCoordinates, geometry);
+					break;
+				case ELEMENTS::TYPE::VTK_PYRAMID:
+					ComputeVolumesAndCentroids<ELEMENTS::TYPE::VTK_PYRAMID>(block.second, vertexCoordinates, geometry);
+					break;
+				default:
+					LOGERROR("Element type not supported by the geometry kernels");
+				}
+			}
+		}
+
+		///Faces
+
+		//Quadrature used by the polygon element for its area, same rule as in Polygon.hpp
+		template <ELEMENTS::TYPE faceType>
+		struct FaceRule;
+
+		template <>
+		struct FaceRule<ELEMENTS::TYPE::VTK_QUAD>
+		{
+			static constexpr int nGauss = 4;
+			static void get_GaussPoint(int g, double& xi_1, double& xi_2, double& weight)
+			{
+				const double alpha = 1. / std::sqrt(3.);
+				const double sign[4][2] = { { -1, -1 },{ 1, -1 },{ 1, 1 },{ -1, 1 } };
+				xi_1 = alpha * sign[g][0]; xi_2 = alpha * sign[g][1]; weight = 1.;
+			}
+			static void get_Center(double& xi_1, double& xi_2) { xi_1 = 0; xi_2 = 0; }
+		};
+
+		template <>
+		struct FaceRule<ELEMENTS::TYPE::VTK_TRIANGLE>
+		{
+			static constexpr int nGauss = 1;
+			static void get_GaussPoint(int, double& xi_1, double& xi_2, double& weight) { xi_1 = 0; xi_2 = 0; weight = 0.5; }
+			static void get_Center(double& xi_1, double& xi_2) { xi_1 = 1. / 3.; xi_2 = 1. / 3.; }
+		};
+
+		//Area, unit normal and centroid of a tile of faces. Area is integrated on the Gauss points of FaceRule,
+		//the normal is taken at the reference point (0,0) and the centroid is the image of the reference center, as for the element.
+		template <ELEMENTS::TYPE faceType>
+		struct FaceTileKernel
+		{
+			typedef ElementSpe<ELEMENTS::FAMILY::POLYGON, faceType> Face;
+			static constexpr int nVertex = Face::nVertex;
+			static constexpr int nGauss = FaceRule<faceType>::nGauss;
+
+			struct Reference
+			{
+				double dN[nGauss][nVertex][2];
+				double weight[nGauss];
+				double dNnormal[nVertex][2];
+				double Ncenter[nVertex];
+
+				Reference()
+				{
+					double xi_1, xi_2;
+					for (int g = 0; g != nGauss; ++g)
+					{
+						FaceRule<faceType>::get_GaussPoint(g, xi_1, xi_2, weight[g]);
+						auto derivatives = Face::get_BasisFunctionDerivatives(xi_1, xi_2);
+						for (int j = 0; j != nVertex; ++j)
+						{
+							dN[g][j][0] = derivatives[j][0];
+							dN[g][j][1] = derivatives[j][1];
+						}
+					}
+					auto derivatives = Face::get_BasisFunctionDerivatives(0., 0.);
+					FaceRule<faceType>::get_Center(xi_1, xi_2);
+					auto basis = Face::get_BasisFunctions(xi_1, xi_2);
+					for (int j = 0; j != nVertex; ++j)
+					{
+						dNnormal[j][0] = derivatives[j][0];
+						dNnormal[j][1] = derivatives[j][1];
+						Ncenter[j] = basis[j];
+					}
+				}
+			};
+
+			//Cross product of the Jacobian columns for derivatives dN
+			static void CrossProduct(const CellTile<nVertex>& tile, const double(&dN)[nVertex][2], double* cx, double* cy, double* cz)
+			{
+				double t1[3][TileWidth], t2[3][TileWidth];
+				for (int r = 0; r != 3; ++r)
+				{
+					std::fill(t1[r], t1[r] + TileWidth, 0.);
+					std::fill(t2[r], t2[r] + TileWidth, 0.);
+				}
+				for (int j = 0; j != nVertex; ++j)
+				{
+					const double d1 = dN[j][0], d2 = dN[j][1];
+					for (int k = 0; k < TileWidth; ++k)
+					{
+						t1[0][k] += tile.x[j][k] * d1; t1[1][k] += tile.y[j][k] * d1; t1[2][k] += tile.z[j][k] * d1;
+						t2[0][k] += tile.x[j][k] * d2; t2[1][k] += tile.y[j][k] * d2; t2[2][k] += tile.z[j][k] * d2;
+					}
+				}
+				for (int k = 0; k < TileWidth; ++k)
+				{
+					cx[k] = t1[1][k] * t2[2][k] - t1[2][k] * t2[1][k];
+					cy[k] = t1[2][k] * t2[0][k] - t1[0][k] * t2[2][k];
+					cz[k] = t1[0][k] * t2[1][k] - t1[1][k] * t2[0][k];
+				}
+			}
+
+			static void Compute(const CellTile<nVertex>& tile, double* area, double* nx, double* ny, double* nz, double* x, double* y, double* z)
+			{
+				static const Reference reference;
+				double cx[TileWidth], cy[TileWidth], cz[TileWidth];
+
+				std::fill(area, area + TileWidth, 0.);
+				for (int g = 0; g != nGauss; ++g)
+				{
+					CrossProduct(tile, reference.dN[g], cx, cy, cz);
+					for (int k = 0; k < TileWidth; ++k)
+					{
+						area[k] += reference.weight[g] * std::sqrt(cx[k] * cx[k] + cy[k] * cy[k] + cz[k] * cz[k]);
+					}
+				}
+
+				CrossProduct(tile, reference.dNnormal, nx, ny, nz);
+				for (int k = 0; k < TileWidth; ++k)
+				{
+					const double length = std::sqrt(nx[k] * nx[k] + ny[k] * ny[k] + nz[k] * nz[k]);
+					const double inv = (length != 0) ? 1. / length : 0.;
+					nx[k] *= inv; ny[k] *= inv; nz[k] *= inv;
+				}
+
+				std::fill(x, x + TileWidth, 0.); std::fill(y, y + TileWidth, 0.); std::fill(z, z + TileWidth, 0.);
+				for (int j = 0; j != nVertex; ++j)
+				{
+					const double N = reference.Ncenter[j];
+					for (int k = 0; k < TileWidth; ++k)
+					{
+						x[k] += tile.x[j][k] * N; y[k] += tile.y[j][k] * N; z[k] += tile.z[j][k] * N;
+					}
+				}
+			}
+		};
+
+		/**
+		 * \brief Compute areas, unit normals and centroids of faces of one type, tiles are shared among threads
+		 * \param faces local indices of the faces, results are written at these positions
+		 * \param vertexCoordinates functor (face, ivertex, x, y, z) giving the coordinates of a vertex
+		 */
+		template <ELEMENTS::TYPE faceType, class VertexCoordinates>
+		void ComputeFaceGeometry(const std::vector<int>& faces, VertexCoordinates&& vertexCoordinates, FaceGeometry& geometry)
+		{
+			constexpr int nVertex = ELEMENTS::TypeTraits<faceType>::nVertex();
+			const int nFaces = static_cast<int>(faces.size());
+			const int nTiles = (nFaces + TileWidth - 1) / TileWidth;
+			utils::parallel_for(0, nTiles, [&](std::ptrdiff_t itile)
+			{
+				CellTile<nVertex> tile;
+				double area[TileWidth], nx[TileWidth], ny[TileWidth], nz[TileWidth], x[TileWidth], y[TileWidth], z[TileWidth];
+				const int start = static_cast<int>(itile) * TileWidth;
+				const int n = std::min(TileWidth, nFaces - start);
+				tile.Gather(faces.data() + start, n, vertexCoordinates);
+				FaceTileKernel<faceType>::Compute(tile, area, nx, ny, nz, x, y, z);
+				for (int k = 0; k < n; ++k)
+				{
+					const auto face = faces[start + k];
+					geometry.area[face] = area[k];
+					geometry.nx[face] = nx[k]; geometry.ny[face] = ny[k]; geometry.nz[face] = nz[k];
+					geometry.x[face] = x[k]; geometry.y[face] = y[k]; geometry.z[face] = z[k];
+				}
+			});
+		}
+
+		/**
+		 * \brief Compute areas, unit normals and centroids of all faces, type by type
+		 * \param blocks local indices of the faces per type
+		 */
+		template <class VertexCoordinates>
+		void ComputeFaceGeometry(const std::map<ELEMENTS::TYPE, std::vector<int>>& blocks, VertexCoordinates&& vertexCoordinates, FaceGeometry& geometry)
+		{
+			for (auto& block : blocks)
+			{
+				switch (block.first)
+				{
+				case ELEMENTS::TYPE::VTK_TRIANGLE:
+					ComputeFaceGeometry<ELEMENTS::TYPE::VTK_TRIANGLE>(block.second, vertexCoordinates, geometry);
+					break;
+				case ELEMENTS::TYPE::VTK_QUAD:
+					ComputeFaceGeometry<ELEMENTS::TYPE::VTK_QUAD>(block.second, vertexCoordinates, geometry);
+					break;
+				default:
+					LOGERROR("Element type not supported by the geometry kernels");
+				}
+			}
+		}
+
+	}
+
+}
@@ -0,0 +1,64 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+#include "Elements/Element.hpp"
+
+namespace PAMELA
+{
+
+	namespace ELEMENTS
+	{
+
+		/**
+		 * \brief Local edges of a polyhedron type, as pairs of local vertices.
+		 * Edges are listed in vtk order.
+		 */
+		struct EdgeTable
+		{
+			static constexpr int maxEdge = 12;
+
+			int nEdge;
+			int vertex[maxEdge][2];
+		};
+
+		constexpr EdgeTable edgeTableOf(TYPE elementType)
+		{
+			switch (elementType)
+			{
+			case TYPE::VTK_TETRA:
+				return { 6,
+					{ { 0, 1 }, { 1, 2 }, { 2, 0 }, { 0, 3 }, { 1, 3 }, { 2, 3 } } };
+			case TYPE::VTK_HEXAHEDRON:
+				return { 12,
+					{ { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 }, { 4, 5 }, { 5, 6 }, { 6, 7 }, { 7, 4 }, { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 } } };
+			case TYPE::VTK_WEDGE:
+				return { 9,
+					{ { 0, 1 }, { 1, 2 }, { 2, 0 }, { 3, 4 }, { 4, 5 }, { 5, 3 }, { 0, 3 }, { 1, 4 }, { 2, 5 } } };
+			case TYPE::VTK_PYRAMID:
+				return { 8,
+					{ { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 }, { 0, 4 }, { 1, 4 }, { 2, 4 }, { 3, 4 } } };
+			default:
+				return { 0, {} };
+			}
+		}
+
+		static_assert(edgeTableOf(TYPE::VTK_TETRA).nEdge == nEdgeOf(TYPE::VTK_TETRA), "Wrong number of edges for tetrahedron");
+		static_assert(edgeTableOf(TYPE::VTK_HEXAHEDRON).nEdge == nEdgeOf(TYPE::VTK_HEXAHEDRON), "Wrong number of edges for hexahedron");
+		static_assert(edgeTableOf(TYPE::VTK_WEDGE).nEdge == nEdgeOf(TYPE::VTK_WEDGE), "Wrong number of edges for wedge");
+		static_assert(edgeTableOf(TYPE::VTK_PYRAMID).nEdge == nEdgeOf(TYPE::VTK_PYRAMID), "Wrong number of edges for pyramid");
+
+	}
+
+}
@@ -30,66 +30,115 @@ namespace PAMELA
 		//Family
 		enum class FAMILY { POLYHEDRON = 3, POLYGON = 2, LINE = 1, POINT = 0, UNKNOWN = -1 };
 
-		static const std::unordered_map<int, int> dimension =
+		constexpr int dimensionOf(FAMILY family)
 		{
-			{ static_cast<int>(FAMILY::POLYHEDRON) ,3 },
-			{ static_cast<int>(FAMILY::POLYGON) ,2 },
-			{ static_cast<int>(FAMILY::LINE) ,1 },
-			{ static_cast<int>(FAMILY::POINT) ,0 },
-			{ static_cast<int>(FAMILY::UNKNOWN) ,-1 },
-		};
+			switch (family)
+			{
+			case FAMILY::POLYHEDRON: return 3;
+			case FAMILY::POLYGON: return 2;
+			case FAMILY::LINE: return 1;
+			case FAMILY::POINT: return 0;
+			default: return -1;
+			}
+		}
 
 		//LABEL
-		const std::unordered_map<int, std::string> label =
+		constexpr const char* labelOf(FAMILY family)
 		{
-			{ static_cast<int>(FAMILY::POLYHEDRON) ,"POLYHEDRON" },
-			{ static_cast<int>(FAMILY::POLYGON) ,"POLYGON" },
-			{ static_cast<int>(FAMILY::LINE) ,"LINE" },
-			{ static_cast<int>(FAMILY::POINT) ,"POINT" },
-			{ static_cast<int>(FAMILY::UNKNOWN) ,"UNKNOWN" },
-		};
+			switch (family)
+			{
+			case FAMILY::POLYHEDRON: return "POLYHEDRON";
+			case FAMILY::POLYGON: return "POLYGON";
+			case FAMILY::LINE: return "LINE";
+			case FAMILY::POINT: return "POINT";
+			default: return "UNKNOWN";
+			}
+		}
 
 
 		//TYPE
 		enum class TYPE { UNKNOWN = -1, VTK_VERTEX = 1, VTK_LINE = 3, VTK_TRIANGLE = 5, VTK_QUAD = 9, VTK_TETRA = 10, VTK_HEXAHEDRON = 12, VTK_WEDGE = 13, VTK_PYRAMID = 14 };
 
-		const std::unordered_map<int, int> nVertex =
+		constexpr int nVertexOf(TYPE elementType)
 		{
-			{ static_cast<int>(TYPE::VTK_VERTEX) ,1 },
-			{ static_cast<int>(TYPE::VTK_LINE) ,1 },
-			{ static_cast<int>(TYPE::VTK_TRIANGLE) ,3 },
-			{ static_cast<int>(TYPE::VTK_QUAD) ,4 },
-			{ static_cast<int>(TYPE::VTK_TETRA) ,4 },
-			{ static_cast<int>(TYPE::VTK_HEXAHEDRON) ,8 },
-			{ static_cast<int>(TYPE::VTK_WEDGE) ,6 },
-			{ static_cast<int>(TYPE::VTK_PYRAMID) ,5 },
-			{ static_cast<int>(TYPE::UNKNOWN),-1 },
-		};
+			switch (elementType)
+			{
+			case TYPE::VTK_VERTEX: return 1;
+			case TYPE::VTK_LINE: return 2;
+			case TYPE::VTK_TRIANGLE: return 3;
+			case TYPE::VTK_QUAD: return 4;
+			case TYPE::VTK_TETRA: return 4;
+			case TYPE::VTK_HEXAHEDRON: return 8;
+			case TYPE::VTK_WEDGE: return 6;
+			case TYPE::VTK_PYRAMID: return 5;
+			default: return -1;
+			}
+		}
 
-		const std::unordered_map<int, int> nFace =
+		constexpr int nFaceOf(TYPE elementType)
 		{
-			{ static_cast<int>(TYPE::VTK_TETRA) ,4 },
-			{ static_cast<int>(TYPE::VTK_HEXAHEDRON) ,8 },
-			{ static_cast<int>(TYPE::VTK_WEDGE) ,5 },
-			{ static_cast<int>(TYPE::VTK_PYRAMID) ,5 },
-			{ static_cast<int>(TYPE::UNKNOWN) ,-1 },
-		};
+			switch (elementType)
+			{
+			case TYPE::VTK_TETRA: return 4;
+			case TYPE::VTK_HEXAHEDRON: return 6;
+			case TYPE::VTK_WEDGE: return 5;
+			case TYPE::VTK_PYRAMID: return 5;
+			case TYPE::UNKNOWN: return -1;
+			default: return 0;
+			}
+		}
+
+		constexpr int nEdgeOf(TYPE elementType)
+		{
+			switch (elementType)
+			{
+			case TYPE::VTK_LINE: return 1;
+			case TYPE::VTK_TRIANGLE: return 3;
+			case TYPE::VTK_QUAD: return 4;
+			case TYPE::VTK_TETRA: return 6;
+			case TYPE::VTK_HEXAHEDRON: return 12;
+			case TYPE::VTK_WEDGE: return 9;
+			case TYPE::VTK_PYRAMID: return 8;
+			case TYPE::UNKNOWN: return -1;
+			default: return 0;
+			}
+		}
 
 
 		//MAPPING
-		const std::unordered_map<int, FAMILY> TypeToFamily =
+		constexpr FAMILY familyOf(TYPE elementType)
 		{
-			{ static_cast<int>(TYPE::VTK_VERTEX) ,FAMILY::POINT },
-			{ static_cast<int>(TYPE::VTK_LINE) ,FAMILY::LINE },
-			{ static_cast<int>(TYPE::VTK_TRIANGLE) ,FAMILY::POLYGON },
-			{ static_cast<int>(TYPE::VTK_QUAD) ,FAMILY::POLYGON },
-			{ static_cast<int>(TYPE::VTK_TETRA) ,FAMILY::POLYHEDRON },
-			{ static_cast<int>(TYPE::VTK_HEXAHEDRON) ,FAMILY::POLYHEDRON },
-			{ static_cast<int>(TYPE::VTK_WEDGE) ,FAMILY::POLYHEDRON },
-			{ static_cast<int>(TYPE::VTK_PYRAMID) ,FAMILY::POLYHEDRON }
+			switch (elementType)
+			{
+			case TYPE::VTK_VERTEX: return FAMILY::POINT;
+			case TYPE::VTK_LINE: return FAMILY::LINE;
+			case TYPE::VTK_TRIANGLE: return FAMILY::POLYGON;
+			case TYPE::VTK_QUAD: return FAMILY::POLYGON;
+			case TYPE::VTK_TETRA: return FAMILY::POLYHEDRON;
+			case TYPE::VTK_HEXAHEDRON: return FAMILY::POLYHEDRON;
+			case TYPE::VTK_WEDGE: return FAMILY::POLYHEDRON;
+			case TYPE::VTK_PYRAMID: return FAMILY::POLYHEDRON;
+			default: return FAMILY::UNKNOWN;
+			}
+		}
 
+		/**
+		 * \brief Compile-time traits of an element type
+		 */
+		template <TYPE elementType>
+		struct TypeTraits
+		{
+			static constexpr TYPE type() { return elementType; }
+			static constexpr FAMILY family() { return familyOf(elementType); }
+			static constexpr int dimension() { return dimensionOf(familyOf(elementType)); }
+			static constexpr int nVertex() { return nVertexOf(elementType); }
+			static constexpr int nFace() { return nFaceOf(elementType); }
+			static constexpr int nEdge() { return nEdgeOf(elementType); }
 		};
 
+		static_assert(TypeTraits<TYPE::VTK_HEXAHEDRON>::nFace() == 6, "Wrong number of faces for hexahedron");
+		static_assert(TypeTraits<TYPE::VTK_WEDGE>::family() == FAMILY::POLYHEDRON, "Wrong family for wedge");
+
     struct EnumClassHash
     {
       template <typename T>
@@ -105,6 +154,8 @@ namespace PAMELA
 	 */
 	class ElementBase
 	{
+		friend class ElementArena;
+
 	public:
 		ElementBase() : m_vtkType(ELEMENTS::TYPE::UNKNOWN), m_family(ELEMENTS::FAMILY::UNKNOWN), m_index(-1),
 		                m_partitionOwner(0), m_IsGhost(false)
@@ -119,7 +170,7 @@ namespace PAMELA
 		int get_localIndex() const { return m_index.Local; }
 		int get_globalIndex() const { return m_index.Global; }
 		int get_initIndex() const { return m_index.Init; }
-		int get_dimension() { return ELEMENTS::dimension.at(static_cast<int>(m_family)); }
+		int get_dimension() { return ELEMENTS::dimensionOf(m_family); }
 		ELEMENTS::FAMILY get_family() { return m_family; }
 		ELEMENTS::TYPE get_vtkType() { return m_vtkType; }
 
@@ -0,0 +1,159 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#include "Elements/ElementArena.hpp"
+#include "Utils/Assert.hpp"
+#include <algorithm>
+#include <functional>
+
+namespace PAMELA
+{
+
+	void* ElementArena::allocate(size_t size)
+	{
+		const size_t headerSize = align(sizeof(Header));
+		const size_t needed = headerSize + align(size);
+
+		//Open a new block if the current one is full
+		if (m_blocks.empty() || (m_blocks[m_currentBlock].data == nullptr) || (m_blocks[m_currentBlock].used + needed > m_blocks[m_currentBlock].size))
+		{
+			Block block;
+			block.size = std::max(m_blockSize, needed);
+			block.data = static_cast<char*>(::operator new(block.size));
+			block.used = 0;
+			block.nbAlive = 0;
+			if (!m_freeBlocks.empty())
+			{
+				m_currentBlock = m_freeBlocks.back();
+				m_freeBlocks.pop_back();
+				m_blocks[m_currentBlock] = block;
+			}
+			else
+			{
+				m_currentBlock = m_blocks.size();
+				m_blocks.push_back(block);
+			}
+			m_blockStart[block.data] = m_currentBlock;
+		}
+
+		Block& block = m_blocks[m_currentBlock];
+		Header* header = reinterpret_cast<Header*>(block.data + block.used);
+		header->block = static_cast<std::uint32_t>(m_currentBlock);
+		header->size = static_cast<std::uint32_t>(needed);
+		header->alive = 1;
+		header->padding = 0;
+
+		void* memory = block.data + block.used + headerSize;
+		block.used += needed;
+		++block.nbAlive;
+		++m_nbElements;
+		return memory;
+	}
+
+	void ElementArena::destroy(ElementBase* element)
+	{
+		if (element == nullptr)
+		{
+			return;
+		}
+
+		Header* header = reinterpret_cast<Header*>(reinterpret_cast<char*>(element) - align(sizeof(Header)));
+		ASSERT(header->alive == 1, "Element is destroyed twice or does not belong to the arena");
+		ASSERT(header->block < m_blocks.size(), "Element does not belong to the arena");
+
+		element->~ElementBase();
+		header->alive = 0;
+
+		auto iblock = static_cast<size_t>(header->block);
+		Block& block = m_blocks[iblock];
+		--block.nbAlive;
+		--m_nbElements;
+
+		if (block.nbAlive == 0)
+		{
+			if (iblock == m_currentBlock)
+			{
+				block.used = 0;
+			}
+			else
+			{
+				releaseBlock(iblock);
+			}
+		}
+	}
+
+	bool ElementArena::owns(const ElementBase* element) const
+	{
+		auto address = reinterpret_cast<const char*>(element);
+		auto it = m_blockStart.upper_bound(address);
+		if (it == m_blockStart.begin())
+		{
+			return false;
+		}
+		--it;
+		const Block& block = m_blocks[it->second];
+		return std::less<const char*>()(address, block.data + block.used);
+	}
+
+	void ElementArena::releaseBlock(size_t iblock)
+	{
+		Block& block = m_blocks[iblock];
+		m_blockStart.erase(block.data);
+		::operator delete(block.data);
+		block.data = nullptr;
+		block.size = 0;
+		block.used = 0;
+		block.nbAlive = 0;
+		m_freeBlocks.push_back(iblock);
+	}
+
+	void ElementArena::Clear()
+	{
+		const size_t headerSize = align(sizeof(Header));
+		for (auto& block : m_blocks)
+		{
+			if (block.data == nullptr)
+			{
+				continue;
+			}
+
+			//Walk the block and destroy the remaining elements
+			size_t offset = 0;
+			while ((offset < block.used) && (block.nbAlive > 0))
+			{
+				Header* header = reinterpret_cast<Header*>(block.data + offset);
+				if (header->alive == 1)
+				{
+					reinterpret_cast<ElementBase*>(block.data + offset + headerSize)->~ElementBase();
+					header->alive = 0;
+					--block.nbAlive;
+				}
+				offset += header->size;
+			}
+			::operator delete(block.data);
+		}
+
+		m_blocks.clear();
+		m_freeBlocks.clear();
+		m_blockStart.clear();
+		m_currentBlock = 0;
+		m_nbElements = 0;
+	}
+
+	size_t ElementArena::get_nbBlocks() const
+	{
+		return static_cast<size_t>(std::count_if(m_blocks.begin(), m_blocks.end(), [](const Block& block) { return block.data != nullptr; }));
+	}
+
+}
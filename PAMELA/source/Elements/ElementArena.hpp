@@ -0,0 +1,112 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "Elements/Element.hpp"
+#include "Utils/Assert.hpp"
+
+namespace PAMELA
+{
+
+	/**
+	 * \brief Block allocator for mesh elements.
+	 * Elements are carved from large blocks. A block is given back to the system as soon as all its elements have been destroyed,
+	 * remaining elements are destroyed with the arena.
+	 */
+	class ElementArena
+	{
+	public:
+
+		explicit ElementArena(size_t blockSize = 1 << 20) : m_blockSize(blockSize) {}
+		~ElementArena() { Clear(); }
+
+		ElementArena(const ElementArena&) = delete;
+		ElementArena& operator=(const ElementArena&) = delete;
+
+		//Construct an element in the arena
+		template <class T, class... Args>
+		T* make(Args&&... args)
+		{
+			static_assert(std::is_base_of<ElementBase, T>::value, "Only elements can be allocated in an ElementArena");
+			void* memory = allocate(sizeof(T));
+			T* element = new (memory) T(std::forward<Args>(args)...);
+			ASSERT(static_cast<void*>(static_cast<ElementBase*>(element)) == memory, "ElementBase must be at the start of the element");
+			return element;
+		}
+
+		//Construct an element in the arena when there is one, on the heap otherwise
+		template <class T, class... Args>
+		static T* create(ElementArena* arena, Args&&... args)
+		{
+			if (arena != nullptr)
+			{
+				return arena->make<T>(std::forward<Args>(args)...);
+			}
+			return new T(std::forward<Args>(args)...);
+		}
+
+		//Destroy an element allocated by this arena
+		void destroy(ElementBase* element);
+
+		//Test if an element has been allocated by this arena
+		bool owns(const ElementBase* element) const;
+
+		//Destroy all elements and release all blocks
+		void Clear();
+
+		//Getters
+		size_t get_nbElements() const { return m_nbElements; }
+		size_t get_nbBlocks() const;
+
+	private:
+
+		struct Header
+		{
+			std::uint32_t block;
+			std::uint32_t size;
+			std::uint32_t alive;
+			std::uint32_t padding;
+		};
+
+		struct Block
+		{
+			char* data;
+			size_t size;
+			size_t used;
+			size_t nbAlive;
+		};
+
+		static constexpr size_t alignment = alignof(std::max_align_t);
+		static size_t align(size_t n) { return (n + alignment - 1) / alignment * alignment; }
+
+		void* allocate(size_t size);
+		void releaseBlock(size_t iblock);
+
+		size_t m_blockSize;
+		size_t m_nbElements = 0;
+		std::vector<Block> m_blocks;
+		std::vector<size_t> m_freeBlocks;
+		std::map<const char*, size_t> m_blockStart;
+		size_t m_currentBlock = 0;
+
+	};
+
+}
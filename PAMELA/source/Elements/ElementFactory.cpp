@@ -19,32 +19,39 @@ namespace PAMELA
 {
   namespace ElementFactory {
 
-    Point* makePoint(ELEMENTS::TYPE elementType, int index, double x, double y, double z)
+    Point* makePoint(ELEMENTS::TYPE elementType, int index, double x, double y, double z, ElementArena* arena)
     {
       ASSERT(elementType == ELEMENTS::TYPE::VTK_VERTEX, "Cannot make a point with this type");
       (void) elementType;
-      return new Vertex(index, x, y, z);
+      return ElementArena::create<Vertex>(arena, index, x, y, z);
     }
 
-    Line* makeLine(ELEMENTS::TYPE elementType, int index, const std::vector<Point*>& vertexList)
+    Point* makePoint(ELEMENTS::TYPE elementType, int index, PointStore* store, PointHandle storeIndex, ElementArena* arena)
+    {
+      ASSERT(elementType == ELEMENTS::TYPE::VTK_VERTEX, "Cannot make a point with this type");
+      (void) elementType;
+      return ElementArena::create<Vertex>(arena, index, store, storeIndex);
+    }
+
+    Line* makeLine(ELEMENTS::TYPE elementType, int index, const std::vector<Point*>& vertexList, ElementArena* arena)
     {
       ASSERT(elementType == ELEMENTS::TYPE::VTK_LINE, "Cannot make a line with this type");
       (void) elementType;
-      return new ElementSpe<ELEMENTS::FAMILY::LINE, ELEMENTS::TYPE::VTK_LINE>(index, vertexList);
+      return ElementArena::create<ElementSpe<ELEMENTS::FAMILY::LINE, ELEMENTS::TYPE::VTK_LINE>>(arena, index, vertexList);
     }
 
-    Polygon* makePolygon(ELEMENTS::TYPE elementType, int index, const std::vector<Point*>& vertexList)
+    Polygon* makePolygon(ELEMENTS::TYPE elementType, int index, const std::vector<Point*>& vertexList, ElementArena* arena)
     {
 
-      ASSERT(ELEMENTS::TypeToFamily.at(static_cast<int>(elementType)) == ELEMENTS::FAMILY::POLYGON, "Element type is not a polygon");
+      ASSERT(ELEMENTS::familyOf(elementType) == ELEMENTS::FAMILY::POLYGON, "Element type is not a polygon");
 
       switch (elementType)
       {
         case ELEMENTS::TYPE::VTK_TRIANGLE:
-          return new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>(index, vertexList);
+          return ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>>(arena, index, vertexList);
 
         case ELEMENTS::TYPE::VTK_QUAD:
-          return new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>(index, vertexList);
+          return ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>>(arena, index, vertexList);
 
         default:
           LOGERROR("Element type is unknown");
@@ -53,25 +60,25 @@ namespace PAMELA
 
     }
 
-    Polyhedron* makePolyhedron(ELEMENTS::TYPE elementType, int index, const std::vector<Point*>& vertexList)
+    Polyhedron* makePolyhedron(ELEMENTS::TYPE elementType, int index, const std::vector<Point*>& vertexList, ElementArena* arena)
     {
 
-      ASSERT(ELEMENTS::TypeToFamily.at(static_cast<int>(elementType)) == ELEMENTS::FAMILY::POLYHEDRON, "Element type is not a polyhedron");
+      ASSERT(ELEMENTS::familyOf(elementType) == ELEMENTS::FAMILY::POLYHEDRON, "Element type is not a polyhedron");
 
       switch (elementType)
       {
 
         case ELEMENTS::TYPE::VTK_HEXAHEDRON:
-          return new ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_HEXAHEDRON>(index, vertexList);
+          return ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_HEXAHEDRON>>(arena, index, vertexList);
 
         case ELEMENTS::TYPE::VTK_TETRA:
-          return new ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_TETRA>(index, vertexList);
+          return ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_TETRA>>(arena, index, vertexList);
 
         case ELEMENTS::TYPE::VTK_PYRAMID:
-          return new ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_PYRAMID>(index, vertexList);
+          return ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_PYRAMID>>(arena, index, vertexList);
 
         case ELEMENTS::TYPE::VTK_WEDGE:
-          return new ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_WEDGE>(index, vertexList);
+          return ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_WEDGE>>(arena, index, vertexList);
 
         default:
           LOGERROR("Element type is unknown");
@@ -19,13 +19,17 @@
 #include "Elements/Polygon.hpp"
 #include "Elements/Line.hpp"
 #include "Elements/Point.hpp"
+#include "Elements/ElementArena.hpp"
 
 namespace PAMELA
 {
   namespace ElementFactory {
-    Point* makePoint(ELEMENTS::TYPE  elementType, int index, double x, double y, double z);
-    Line*  makeLine(ELEMENTS::TYPE  elementType, int index, const std::vector<Point*>& vertexList);
-    Polygon*  makePolygon(ELEMENTS::TYPE  elementType, int index, const std::vector<Point*>& vertexList);
-    Polyhedron* makePolyhedron(ELEMENTS::TYPE elementType, int index, const std::vector<Point*>& vertexList);
+    //Elements are allocated in arena when provided, on the heap otherwise
+    Point* makePoint(ELEMENTS::TYPE  elementType, int index, double x, double y, double z, ElementArena* arena = nullptr);
+    //Point created as a view on coordinates already in a store
+    Point* makePoint(ELEMENTS::TYPE  elementType, int index, PointStore* store, PointHandle storeIndex, ElementArena* arena = nullptr);
+    Line*  makeLine(ELEMENTS::TYPE  elementType, int index, const std::vector<Point*>& vertexList, ElementArena* arena = nullptr);
+    Polygon*  makePolygon(ELEMENTS::TYPE  elementType, int index, const std::vector<Point*>& vertexList, ElementArena* arena = nullptr);
+    Polyhedron* makePolyhedron(ELEMENTS::TYPE elementType, int index, const std::vector<Point*>& vertexList, ElementArena* arena = nullptr);
   }
 }
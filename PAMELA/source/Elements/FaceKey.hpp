@@ -0,0 +1,99 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include "Elements/Point.hpp"
+#include "Utils/Assert.hpp"
+#include "Utils/Utils.hpp"
+
+namespace PAMELA
+{
+
+	/**
+	 * \brief Canonical key of a face: its sorted vertex local indices packed in two 64-bit words.
+	 * Faces with the same vertices have the same key whatever the vertex order, building a key does not allocate.
+	 */
+	struct FaceKey
+	{
+		static constexpr int maxVertex = 4;
+		static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+		FaceKey() = default;
+
+		explicit FaceKey(const std::vector<Point*>& vertexList)
+		{
+			ASSERT(vertexList.size() <= static_cast<size_t>(maxVertex), "Face has too many vertices");
+			std::uint32_t v[maxVertex] = { none, none, none, none };
+			for (size_t i = 0; i != vertexList.size(); ++i)
+			{
+				v[i] = static_cast<std::uint32_t>(vertexList[i]->get_localIndex());
+			}
+			pack(v);
+		}
+
+		//Key from nVertex vertex indices, any consistent numbering of the points can be used
+		FaceKey(const std::uint32_t* vertices, int nVertex)
+		{
+			ASSERT(nVertex <= maxVertex, "Face has too many vertices");
+			std::uint32_t v[maxVertex] = { none, none, none, none };
+			for (int i = 0; i != nVertex; ++i)
+			{
+				v[i] = vertices[i];
+			}
+			pack(v);
+		}
+
+		bool operator==(const FaceKey& rhs) const { return (w[0] == rhs.w[0]) && (w[1] == rhs.w[1]); }
+		bool operator!=(const FaceKey& rhs) const { return !(*this == rhs); }
+		bool operator<(const FaceKey& rhs) const { return (w[0] < rhs.w[0]) || ((w[0] == rhs.w[0]) && (w[1] < rhs.w[1])); }
+
+		std::uint64_t w[2];
+
+	private:
+
+		void pack(std::uint32_t* v)
+		{
+			//Sorting network
+			sort2(v[0], v[1]); sort2(v[2], v[3]);
+			sort2(v[0], v[2]); sort2(v[1], v[3]);
+			sort2(v[1], v[2]);
+
+			w[0] = (static_cast<std::uint64_t>(v[0]) << 32) | v[1];
+			w[1] = (static_cast<std::uint64_t>(v[2]) << 32) | v[3];
+		}
+
+		static void sort2(std::uint32_t& a, std::uint32_t& b)
+		{
+			if (b < a)
+			{
+				std::swap(a, b);
+			}
+		}
+
+	};
+
+	struct FaceKeyHash
+	{
+		std::size_t operator()(const FaceKey& key) const
+		{
+			return static_cast<std::size_t>(utils::mixHash(utils::mixHash(key.w[0]) ^ key.w[1]));
+		}
+	};
+
+}
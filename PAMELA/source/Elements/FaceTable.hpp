@@ -0,0 +1,75 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+#include "Elements/Element.hpp"
+
+namespace PAMELA
+{
+
+	namespace ELEMENTS
+	{
+
+		/**
+		 * \brief Local faces of a polyhedron type: vtk type and local vertices of each face.
+		 * Faces are listed in the order of Polyhedron::CreateFaces, with the same vertex order.
+		 */
+		struct FaceTable
+		{
+			static constexpr int maxFace = 6;
+			static constexpr int maxVertex = 4;
+
+			int nFace;
+			TYPE faceType[maxFace];
+			int nVertex[maxFace];
+			int vertex[maxFace][maxVertex];
+		};
+
+		constexpr FaceTable faceTableOf(TYPE elementType)
+		{
+			switch (elementType)
+			{
+			case TYPE::VTK_TETRA:
+				return { 4,
+					{ TYPE::VTK_TRIANGLE, TYPE::VTK_TRIANGLE, TYPE::VTK_TRIANGLE, TYPE::VTK_TRIANGLE },
+					{ 3, 3, 3, 3 },
+					{ { 0, 1, 2 }, { 0, 1, 3 }, { 1, 2, 3 }, { 2, 0, 3 } } };
+			case TYPE::VTK_HEXAHEDRON:
+				return { 6,
+					{ TYPE::VTK_QUAD, TYPE::VTK_QUAD, TYPE::VTK_QUAD, TYPE::VTK_QUAD, TYPE::VTK_QUAD, TYPE::VTK_QUAD },
+					{ 4, 4, 4, 4, 4, 4 },
+					{ { 0, 1, 5, 4 }, { 1, 2, 6, 5 }, { 2, 3, 7, 6 }, { 3, 0, 4, 7 }, { 4, 5, 6, 7 }, { 0, 1, 2, 3 } } };
+			case TYPE::VTK_WEDGE:
+				return { 5,
+					{ TYPE::VTK_TRIANGLE, TYPE::VTK_TRIANGLE, TYPE::VTK_QUAD, TYPE::VTK_QUAD, TYPE::VTK_QUAD },
+					{ 3, 3, 4, 4, 4 },
+					{ { 0, 1, 2 }, { 3, 4, 5 }, { 0, 1, 4, 3 }, { 3, 0, 2, 5 }, { 4, 1, 2, 5 } } };
+			case TYPE::VTK_PYRAMID:
+				return { 5,
+					{ TYPE::VTK_TRIANGLE, TYPE::VTK_TRIANGLE, TYPE::VTK_TRIANGLE, TYPE::VTK_TRIANGLE, TYPE::VTK_QUAD },
+					{ 3, 3, 3, 3, 4 },
+					{ { 3, 0, 4 }, { 0, 1, 4 }, { 4, 1, 2 }, { 2, 3, 4 }, { 0, 1, 2, 3 } } };
+			default:
+				return { 0, {}, {}, {} };
+			}
+		}
+
+		static_assert(faceTableOf(TYPE::VTK_TETRA).nFace == nFaceOf(TYPE::VTK_TETRA), "Wrong number of faces for tetrahedron");
+		static_assert(faceTableOf(TYPE::VTK_HEXAHEDRON).nFace == nFaceOf(TYPE::VTK_HEXAHEDRON), "Wrong number of faces for hexahedron");
+		static_assert(faceTableOf(TYPE::VTK_WEDGE).nFace == nFaceOf(TYPE::VTK_WEDGE), "Wrong number of faces for wedge");
+		static_assert(faceTableOf(TYPE::VTK_PYRAMID).nFace == nFaceOf(TYPE::VTK_PYRAMID), "Wrong number of faces for pyramid");
+
+	}
+
+}
@@ -58,8 +58,7 @@ namespace PAMELA
 	public:
 		ElementSpe(int index, const std::vector<Point*>& vertexList) :Element(index, vertexList)
 		{
-			ELEMENTS::nVertex.at(static_cast<int>(elementType));
-			ASSERT(ELEMENTS::TypeToFamily.at(static_cast<int>(elementType)) == m_family, "Type not compatible with family");
+			static_assert(ELEMENTS::TypeTraits<elementType>::family() == ELEMENTS::FAMILY::LINE, "Type not compatible with family");
 			m_vtkType = elementType;
 		}
 
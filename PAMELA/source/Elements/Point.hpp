@@ -14,6 +14,7 @@
 
 #pragma once
 #include "Utils/SimpleMaths.hpp"
+#include "Collection/PointStore.hpp"
 #include "Elements/Element.hpp"
 #include "Utils/Assert.hpp"
 #include "Utils/Utils.hpp"
@@ -29,27 +30,95 @@ namespace PAMELA
 	{
 	public:
 
-		Element(int index, double x, double y, double z) :ElementBase(), m_coordinates(Coordinates(x, y, z))
+		Element(int index, double x, double y, double z) :ElementBase(), m_coordinates(new Coordinates(x, y, z))
 		{
                         utils::pamela_unused(index);
 			m_family = ELEMENTS::FAMILY::POINT;
-			m_vertexList = { this };
                         m_index.Init = index;
 		}
 
+		//View on a point already in a store
+		Element(int index, PointStore* store, PointHandle storeIndex) :ElementBase(), m_store(store), m_storeIndex(storeIndex)
+		{
+			ASSERT(store != nullptr, "A point view needs a store");
+			m_family = ELEMENTS::FAMILY::POINT;
+			m_index.Init = index;
+		}
+
+		~Element() override
+		{
+			if (m_store == nullptr)
+			{
+				delete m_coordinates;
+			}
+		}
+
+		Element(const Element&) = delete;
+		Element& operator=(const Element&) = delete;
+
 
 		//Getters
-		const Coordinates& get_coordinates() const { return m_coordinates; }
-		Coordinates& get_coordinates() { return m_coordinates; }
+		Coordinates get_coordinates() const
+		{
+			if (m_store != nullptr)
+			{
+				return m_store->get_coordinates(m_storeIndex);
+			}
+			return *m_coordinates;
+		}
+
+		PointStore* get_store() const { return m_store; }
+		PointHandle get_storeIndex() const { return (m_store != nullptr) ? m_storeIndex : -1; }
+
+		//Setters
+		void set_coordinates(const Coordinates& coord)
+		{
+			if (m_store != nullptr)
+			{
+				m_store->set_coordinates(m_storeIndex, coord);
+			}
+			else
+			{
+				*m_coordinates = coord;
+			}
+		}
+		void set_storeIndex(PointHandle i)
+		{
+			ASSERT(m_store != nullptr, "Point is not attached to a store");
+			m_storeIndex = i;
+		}
+
+		//Move the coordinates into a point store, the point then becomes a view on it
+		void AttachToStore(PointStore* store)
+		{
+			ASSERT(m_store == nullptr, "Point is already attached to a store");
+			auto coordinates = m_coordinates;
+			m_store = store;
+			m_storeIndex = store->push_back(*coordinates);
+			delete coordinates;
+		}
+
+		//Copy back the coordinates from the store, the point is then independent from it
+		void DetachFromStore()
+		{
+			ASSERT(m_store != nullptr, "Point is not attached to a store");
+			auto coordinates = new Coordinates(get_coordinates());
+			m_store = nullptr;
+			m_coordinates = coordinates;
+		}
 
 		//Getter
-		const std::vector<Element<ELEMENTS::FAMILY::POINT>*>& get_vertexList() const { return m_vertexList; }
+		std::vector<Element<ELEMENTS::FAMILY::POINT>*> get_vertexList() { return { this }; }
 
 	protected:
 
-		Coordinates m_coordinates;
-
-		std::vector<Element<ELEMENTS::FAMILY::POINT>*> m_vertexList;
+		//A stored point is only a view on the store, a detached point owns its coordinates
+		PointStore* m_store = nullptr;
+		union
+		{
+			PointHandle m_storeIndex;
+			Coordinates* m_coordinates;
+		};
 
 	};
 	typedef Element<ELEMENTS::FAMILY::POINT> Point;
@@ -63,8 +132,13 @@ namespace PAMELA
 
 		ElementSpe(int index, double x, double y, double z) :Element(index, x, y, z)
 		{
-			ELEMENTS::nVertex.at(static_cast<int>(elementType));
-			ASSERT(ELEMENTS::TypeToFamily.at(static_cast<int>(elementType)) == m_family, "Type not compatible with family");
+			static_assert(ELEMENTS::TypeTraits<elementType>::family() == ELEMENTS::FAMILY::POINT, "Type not compatible with family");
+			m_vtkType = elementType;
+		}
+
+		ElementSpe(int index, PointStore* store, PointHandle storeIndex) :Element(index, store, storeIndex)
+		{
+			static_assert(ELEMENTS::TypeTraits<elementType>::family() == ELEMENTS::FAMILY::POINT, "Type not compatible with family");
 			m_vtkType = elementType;
 		}
 
@@ -14,6 +14,8 @@
 
 #pragma once
 #include <vector>
+#include <array>
+#include <utility>
 #include "Elements/Point.hpp"
 #include "Utils/SimpleMaths.hpp"
 #include "Line.hpp"
@@ -45,144 +47,124 @@ namespace PAMELA
 
 		//Geometry
 		virtual double get_SurfaceArea() = 0;
-		virtual std::pair<std::vector <double>, std::vector <double>> get_NormalVectorAndCoordinates() = 0;
-		virtual std::vector <double> get_centroidCoordinates() = 0;
+		virtual std::pair<Vec3, Vec3> get_NormalVectorAndCoordinates() = 0;
+		virtual Vec3 get_centroidCoordinates() = 0;
 		//virtual std::vector <double> get_centroidCoordinates() { return{ 0,0,0 }; }
 	protected:
 
 		std::vector<Point*> m_vertexList;
 
-		//Functions
-		virtual std::vector <double> get_BasisFunctions(double xi_1, double xi_2) = 0;
-		virtual std::vector<std::vector<double>> get_BasisFunctionDerivatives(double xi_1, double xi_2) = 0;
-		std::vector <double> get_RealSpaceCoordinatesFromReferenceSpace(double xi_1, double xi_2);
-		std::pair<std::vector<std::vector<double>>, std::vector <double>> get_JacobianMatrixAndCrossProduct(double xi_1, double xi_2);
-		std::pair<std::vector <double>, std::vector <double>> get_NormalVectorAndCoordinates(double xi_1, double xi_2);
-
-
 	};
 
 	typedef Element<ELEMENTS::FAMILY::POLYGON> Polygon;
 
+
 	/**
-	 * \brief From reference to real space
-	 * \param xi_1
-	 * \param xi_2
-	 * \return
+	 * \brief
+	 * \tparam elementType
 	 */
-	inline std::vector<double> Element<ELEMENTS::FAMILY::POLYGON>::get_RealSpaceCoordinatesFromReferenceSpace(double xi_1, double xi_2)
+	template <ELEMENTS::TYPE elementType>
+	class ElementSpe<ELEMENTS::FAMILY::POLYGON, elementType> final : public Element<ELEMENTS::FAMILY::POLYGON>
 	{
-		std::vector<double> coordinate = { 0, 0, 0 };
-		std::vector<double> basis_function = get_BasisFunctions(xi_1, xi_2);
+	public:
+
+		static constexpr int nVertex = ELEMENTS::TypeTraits<elementType>::nVertex();
 
-		for (auto i = 0; i != static_cast<int>(m_vertexList.size()); ++i)
+		//Basis functions and their derivatives with respect to the reference coordinates, one entry per vertex
+		typedef std::array<double, nVertex> BasisFunctions;
+		typedef std::array<std::array<double, 2>, nVertex> BasisFunctionDerivatives;
+
+		ElementSpe(int index, const std::vector<Point*>& vertexList) :Element(index, vertexList)
 		{
-			coordinate[0] = coordinate[0] + m_vertexList[i]->get_coordinates().x * basis_function[i];
-			coordinate[1] = coordinate[1] + m_vertexList[i]->get_coordinates().y * basis_function[i];
-			coordinate[2] = coordinate[2] + m_vertexList[i]->get_coordinates().z * basis_function[i];
+			ASSERT(vertexList.size() == static_cast<unsigned int>(nVertex), "Vertex list size is not compatible with the element type");
+			static_assert(ELEMENTS::TypeTraits<elementType>::family() == ELEMENTS::FAMILY::POLYGON, "Type not compatible with family");
+			m_vtkType = elementType;
 		}
 
-		return coordinate;
+		//Geometry
+		double get_SurfaceArea() override;
+		Vec3 get_centroidCoordinates() override;
+		std::pair<Vec3, Vec3> get_NormalVectorAndCoordinates() override;
 
-	}
+		//Reference element
+		static BasisFunctions get_BasisFunctions(double xi_1, double xi_2);
+		static BasisFunctionDerivatives get_BasisFunctionDerivatives(double xi_1, double xi_2);
+
+	private:
+
+		//Functions
+		Vec3 get_RealSpaceCoordinatesFromReferenceSpace(double xi_1, double xi_2);
+		Vec3 get_JacobianCrossProduct(double xi_1, double xi_2);
+		std::pair<Vec3, Vec3> get_NormalVectorAndCoordinates(double xi_1, double xi_2);
+
+	};
 
 	/**
-	 * \brief
+	 * \brief From reference to real space
 	 * \param xi_1
 	 * \param xi_2
 	 * \return
 	 */
-	inline std::pair<std::vector<std::vector<double>>, std::vector<double>> Element<ELEMENTS::FAMILY::POLYGON>::get_JacobianMatrixAndCrossProduct(double xi_1, double xi_2)
+	template <ELEMENTS::TYPE elementType>
+	inline Vec3 ElementSpe<ELEMENTS::FAMILY::POLYGON, elementType>::get_RealSpaceCoordinatesFromReferenceSpace(double xi_1, double xi_2)
 	{
-		std::vector<std::vector<double>> matrix;
-		auto basis_function_derivatives_matrix = get_BasisFunctionDerivatives(xi_1, xi_2);
-		std::pair<std::vector<std::vector<double>>, std::vector<double>> result;
-
-		matrix = { { 0, 0 },{ 0, 0 },{ 0, 0 } };
+		Vec3 coordinate;
+		BasisFunctions basis_function = get_BasisFunctions(xi_1, xi_2);
 
-
-		for (auto i = 0; i != 2; ++i)
+		for (auto i = 0; i != nVertex; ++i)
 		{
-			for (auto j = 0; j != static_cast<int>(m_vertexList.size()); ++j)
-			{
-				matrix[0][i] = matrix[0][i] + m_vertexList[j]->get_coordinates().x * basis_function_derivatives_matrix[j][i];
-				matrix[1][i] = matrix[1][i] + m_vertexList[j]->get_coordinates().y * basis_function_derivatives_matrix[j][i];
-				matrix[2][i] = matrix[2][i] + m_vertexList[j]->get_coordinates().z * basis_function_derivatives_matrix[j][i];
-			}
+			auto vertex = m_vertexList[i]->get_coordinates();
+			coordinate[0] = coordinate[0] + vertex.x * basis_function[i];
+			coordinate[1] = coordinate[1] + vertex.y * basis_function[i];
+			coordinate[2] = coordinate[2] + vertex.z * basis_function[i];
 		}
 
-		std::vector<double> vector_1 = { matrix[0][0], matrix[1][0], matrix[2][0] };
-		std::vector<double> vector_2 = { matrix[0][1], matrix[1][1], matrix[2][1] };
-
-		std::vector<double> cross_product_vector = cross_product(vector_1, vector_2);
-
-		result.first = matrix;
-		result.second = cross_product_vector;
-
-		return result;
+		return coordinate;
 
 	}
 
-
 	/**
-	 * \brief
+	 * \brief Cross product of the two columns of the Jacobian matrix
 	 * \param xi_1
 	 * \param xi_2
 	 * \return
 	 */
-	inline std::pair<std::vector<double>, std::vector<double>> Element<ELEMENTS::FAMILY::POLYGON>::get_NormalVectorAndCoordinates(double xi_1, double xi_2)
+	template <ELEMENTS::TYPE elementType>
+	inline Vec3 ElementSpe<ELEMENTS::FAMILY::POLYGON, elementType>::get_JacobianCrossProduct(double xi_1, double xi_2)
 	{
+		BasisFunctionDerivatives basis_function_derivatives_matrix = get_BasisFunctionDerivatives(xi_1, xi_2);
+		Vec3 vector_1, vector_2;
 
-		std::pair<std::vector<double>, std::vector<double>>  result;
-
-		std::vector<double> cross_product_vector = get_JacobianMatrixAndCrossProduct(xi_1, xi_2).second;
-		double vnorm = norm(cross_product_vector);
-		std::vector<double> normal_vector(3);
-		for (auto i = 0; i != 3; ++i)
+		for (auto j = 0; j != nVertex; ++j)
 		{
-			normal_vector[i] = cross_product_vector[i] / vnorm;
+			auto vertex = m_vertexList[j]->get_coordinates();
+			vector_1[0] = vector_1[0] + vertex.x * basis_function_derivatives_matrix[j][0];
+			vector_1[1] = vector_1[1] + vertex.y * basis_function_derivatives_matrix[j][0];
+			vector_1[2] = vector_1[2] + vertex.z * basis_function_derivatives_matrix[j][0];
+			vector_2[0] = vector_2[0] + vertex.x * basis_function_derivatives_matrix[j][1];
+			vector_2[1] = vector_2[1] + vertex.y * basis_function_derivatives_matrix[j][1];
+			vector_2[2] = vector_2[2] + vertex.z * basis_function_derivatives_matrix[j][1];
 		}
 
-		std::vector<double> coordinates = get_RealSpaceCoordinatesFromReferenceSpace(xi_1, xi_2);
+		return cross_product(vector_1, vector_2);
 
-		result.first = normal_vector;
-		result.second = coordinates;
-
-		return result;
 	}
 
 
 	/**
 	 * \brief
-	 * \tparam elementType
+	 * \param xi_1
+	 * \param xi_2
+	 * \return
 	 */
 	template <ELEMENTS::TYPE elementType>
-	class ElementSpe<ELEMENTS::FAMILY::POLYGON, elementType> : public Element<ELEMENTS::FAMILY::POLYGON>
+	inline std::pair<Vec3, Vec3> ElementSpe<ELEMENTS::FAMILY::POLYGON, elementType>::get_NormalVectorAndCoordinates(double xi_1, double xi_2)
 	{
-	public:
-
-		ElementSpe(int index, const std::vector<Point*>& vertexList) :Element(index, vertexList)
-		{
-			ELEMENTS::nVertex.at(static_cast<int>(m_vtkType));
-			ASSERT(vertexList.size() == static_cast<unsigned int>(ELEMENTS::nVertex.at(static_cast<int>(elementType))), "Vertex list size is not compatible with the element type");
-			ASSERT(ELEMENTS::TypeToFamily.at(static_cast<int>(elementType)) == m_family, "Type not compatible with family");
-			m_vtkType = elementType;
-		}
+		Vec3 normal_vector = get_JacobianCrossProduct(xi_1, xi_2);
+		normal_vector *= 1. / norm(normal_vector);
 
-		//Geometry
-		double get_SurfaceArea() override;
-		std::vector <double> get_centroidCoordinates() override;
-		//std::vector <double> get_centroidCoordinates();
-
-	private:
-
-		//Functions
-		std::vector <double> get_BasisFunctions(double xi_1, double xi_2) override;
-		std::vector<std::vector<double>> get_BasisFunctionDerivatives(double xi_1, double xi_2) override;
-		std::pair<std::vector <double>, std::vector <double>> get_NormalVectorAndCoordinates() override;
-
-
-	};
+		return std::make_pair(normal_vector, get_RealSpaceCoordinatesFromReferenceSpace(xi_1, xi_2));
+	}
 
 
 
@@ -196,25 +178,14 @@ namespace PAMELA
 	template <>
 	inline double ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>::get_SurfaceArea()
 	{
-		std::vector<double> Gauss_weight(4);
-		Gauss_weight[0] = 1.;
-		Gauss_weight[1] = 1.;
-		Gauss_weight[2] = 1.;
-		Gauss_weight[3] = 1.;
-
-		double alpha = 1. / sqrt(3);
-		std::vector<std::vector<double>> Gauss_point(4);
-		Gauss_point[0] = { -alpha, -alpha };
-		Gauss_point[1] = { alpha, -alpha };
-		Gauss_point[2] = { alpha, alpha };
-		Gauss_point[3] = { -alpha, alpha };
+		//Gauss weights are all 1
+		const double alpha = 1. / std::sqrt(3.);
+		const double Gauss_point[4][2] = { { -alpha, -alpha },{ alpha, -alpha },{ alpha, alpha },{ -alpha, alpha } };
 
 		double surface_area = 0;
-		std::vector<double> cross_product_vector;
 		for (auto i = 0; i != 4; ++i)
 		{
-			cross_product_vector = get_JacobianMatrixAndCrossProduct(Gauss_point[i][0], Gauss_point[i][1]).second;
-			surface_area = surface_area + Gauss_weight[i] * norm(cross_product_vector);
+			surface_area = surface_area + norm(get_JacobianCrossProduct(Gauss_point[i][0], Gauss_point[i][1]));
 		}
 
 		return surface_area;
@@ -226,7 +197,7 @@ namespace PAMELA
 	* \return
 	*/
 	template <>
-	inline std::vector<double> ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>::get_centroidCoordinates()
+	inline Vec3 ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>::get_centroidCoordinates()
 	{
 		return get_RealSpaceCoordinatesFromReferenceSpace(0, 0);
 	}
@@ -237,40 +208,30 @@ namespace PAMELA
 	* \return
 	*/
 	template <>
-	inline std::pair<std::vector<double>, std::vector<double>> ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>::get_NormalVectorAndCoordinates()
+	inline std::pair<Vec3, Vec3> ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>::get_NormalVectorAndCoordinates()
 	{
-		return Element<ELEMENTS::FAMILY::POLYGON>::get_NormalVectorAndCoordinates(0., 0.);
+		return get_NormalVectorAndCoordinates(0., 0.);
 	}
 
 	template <>
-	inline std::vector<double> ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>::get_BasisFunctions(double xi_1, double xi_2)
+	inline ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>::BasisFunctions ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>::get_BasisFunctions(double xi_1, double xi_2)
 	{
-		std::vector<double> basis_functions;
-
-		basis_functions.push_back(1. / 4. * (1 - xi_1) * (1 - xi_2));
-		basis_functions.push_back(1. / 4. * (1 + xi_1) * (1 - xi_2));
-		basis_functions.push_back(1. / 4. * (1 + xi_1) * (1 + xi_2));
-		basis_functions.push_back(1. / 4. * (1 - xi_1) * (1 + xi_2));
-
-		return basis_functions;
+		return {{
+			1. / 4. * (1 - xi_1) * (1 - xi_2),
+			1. / 4. * (1 + xi_1) * (1 - xi_2),
+			1. / 4. * (1 + xi_1) * (1 + xi_2),
+			1. / 4. * (1 - xi_1) * (1 + xi_2) }};
 
 	}
 
 	template <>
-	inline std::vector<std::vector<double>> ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>::get_BasisFunctionDerivatives(double xi_1, double xi_2)
+	inline ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>::BasisFunctionDerivatives ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>::get_BasisFunctionDerivatives(double xi_1, double xi_2)
 	{
-		std::vector<double> row;
-		std::vector<std::vector<double>> matrix;
-
-		row = { -1. / 4. * (1 - xi_2), -1. / 4. * (1 - xi_1) };
-		matrix.push_back(row);
-		row = { 1. / 4. * (1 - xi_2), -1. / 4. * (1 + xi_1) };
-		matrix.push_back(row);
-		row = { 1. / 4. * (1 + xi_2), 1. / 4. * (1 + xi_1) };
-		matrix.push_back(row);
-		row = { -1. / 4. * (1 + xi_2), 1. / 4. * (1 - xi_1) };
-		matrix.push_back(row);
-		return matrix;
+		return {{
+			{{ -1. / 4. * (1 - xi_2), -1. / 4. * (1 - xi_1) }},
+			{{ 1. / 4. * (1 - xi_2), -1. / 4. * (1 + xi_1) }},
+			{{ 1. / 4. * (1 + xi_2), 1. / 4. * (1 + xi_1) }},
+			{{ -1. / 4. * (1 + xi_2), 1. / 4. * (1 - xi_1) }} }};
 
 	}
 
@@ -283,12 +244,8 @@ namespace PAMELA
 	template <>
 	inline double ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>::get_SurfaceArea()
 	{
-		double surface_area = 0;
-		std::vector<double> cross_product_vector;
-		cross_product_vector = get_JacobianMatrixAndCrossProduct(0, 0).second;
-		surface_area = norm(cross_product_vector);
-
-		return surface_area;
+		//Reference triangle has area 1/2
+		return 0.5 * norm(get_JacobianCrossProduct(0, 0));
 	}
 
 	/**
@@ -296,21 +253,15 @@ namespace PAMELA
 	* \return
 	*/
 	template <>
-	inline std::pair<std::vector<double>, std::vector<double>> ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>::get_NormalVectorAndCoordinates()
+	inline std::pair<Vec3, Vec3> ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>::get_NormalVectorAndCoordinates()
 	{
-		return Element<ELEMENTS::FAMILY::POLYGON>::get_NormalVectorAndCoordinates(0., 0.);
+		return get_NormalVectorAndCoordinates(0., 0.);
 	}
 
 	template <>
-	inline std::vector<double> ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>::get_BasisFunctions(double xi_1, double xi_2)
+	inline ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>::BasisFunctions ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>::get_BasisFunctions(double xi_1, double xi_2)
 	{
-		std::vector<double> basis_functions;
-
-		basis_functions.push_back(1 - xi_1 - xi_2);
-		basis_functions.push_back(xi_1);
-		basis_functions.push_back(xi_2);
-
-		return basis_functions;
+		return {{ 1 - xi_1 - xi_2, xi_1, xi_2 }};
 
 	}
 
@@ -320,7 +271,7 @@ namespace PAMELA
 	//* \return
 	//*/
 	template <>
-	inline std::vector<double> ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>::get_centroidCoordinates()
+	inline Vec3 ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>::get_centroidCoordinates()
 	{
 		return get_RealSpaceCoordinatesFromReferenceSpace(1. / 3., 1. / 3.);
 	}
@@ -333,20 +284,11 @@ namespace PAMELA
 	* \return
 	*/
 	template <>
-	inline std::vector<std::vector<double>> ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>::get_BasisFunctionDerivatives(double xi_1, double xi_2)
+	inline ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>::BasisFunctionDerivatives ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>::get_BasisFunctionDerivatives(double xi_1, double xi_2)
 	{
                 utils::pamela_unused(xi_1);
                 utils::pamela_unused(xi_2);
-		std::vector<double> row;
-		std::vector<std::vector<double>> matrix;
-
-		row = { -1,-1 };
-		matrix.push_back(row);
-		row = { 1,0 };
-		matrix.push_back(row);
-		row = { 0,1 };
-		matrix.push_back(row);
-		return matrix;
+		return {{ {{ -1, -1 }}, {{ 1, 0 }}, {{ 0, 1 }} }};
 	}
 
 
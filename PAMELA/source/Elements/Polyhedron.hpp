@@ -13,12 +13,15 @@
  */
 
 #pragma once
+#include <array>
+#include <utility>
 #include "Elements/Point.hpp"
 #include "Utils/SimpleMaths.hpp"
 #include "Line.hpp"
 #include "Elements/Polygon.hpp"
 #include "Utils/Assert.hpp"
 #include "Elements/Element.hpp"
+#include "Elements/ElementArena.hpp"
 
 namespace PAMELA
 {
@@ -38,23 +41,60 @@ namespace PAMELA
       m_family = ELEMENTS::FAMILY::POLYHEDRON;
     }
 
-    virtual std::vector<Polygon*> CreateFaces() = 0;
+    //Faces are allocated in arena when provided
+    virtual std::vector<Polygon*> CreateFaces(ElementArena* arena = nullptr) = 0;
     //Getter
     const std::vector<Point*>& get_vertexList() const { return m_vertexList; }
     std::vector<Point*>& get_vertexList() { return m_vertexList; }
 
     //Geometry
     virtual double get_Volume() = 0;
-    virtual std::vector <double> get_centroidCoordinates() = 0;
+    virtual Vec3 get_centroidCoordinates() = 0;
 
   protected:
 
     std::vector<Point*> m_vertexList;
 
-    virtual std::vector <double> get_BasisFunctions(double xi_1, double xi_2, double xi_3) = 0;
-    virtual std::vector<std::vector<double>> get_BasisFunctionDerivatives(double xi_1, double xi_2, double xi_3) = 0;
-    std::vector <double> get_RealSpaceCoordinatesFromReferenceSpace(double xi_1, double xi_2, double xi_3);
-    std::pair<std::vector<std::vector<double>>, double> get_JacobianMatrixAndDeterminant(double xi_1, double xi_2, double xi_3);
+  };
+
+  typedef Element<ELEMENTS::FAMILY::POLYHEDRON> Polyhedron;
+
+
+  template <ELEMENTS::TYPE elementType>
+  class ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, elementType> final : public Element<ELEMENTS::FAMILY::POLYHEDRON>
+  {
+  public:
+
+    static constexpr int nVertex = ELEMENTS::TypeTraits<elementType>::nVertex();
+
+    //Basis functions and their derivatives with respect to the reference coordinates, one entry per vertex
+    typedef std::array<double, nVertex> BasisFunctions;
+    typedef std::array<std::array<double, 3>, nVertex> BasisFunctionDerivatives;
+
+    ElementSpe(int index, const std::vector<Point*>& vertexList) :Element(index, vertexList)
+    {
+      ASSERT(vertexList.size() == static_cast<unsigned int>(nVertex), "Vertex list size is not compatible with the element type");
+      static_assert(ELEMENTS::TypeTraits<elementType>::family() == ELEMENTS::FAMILY::POLYHEDRON, "Type not compatible with family");
+      m_vtkType = elementType;
+    }
+
+    //Actions
+    std::vector<Polygon*> CreateFaces(ElementArena* arena = nullptr) override;
+
+    //Geometry
+    double get_Volume() override;
+    Vec3 get_centroidCoordinates() override;
+
+    //Reference element
+    static BasisFunctions get_BasisFunctions(double xi_1, double xi_2, double xi_3);
+    static BasisFunctionDerivatives get_BasisFunctionDerivatives(double xi_1, double xi_2, double xi_3);
+
+
+  private:
+
+    //Functions
+    Vec3 get_RealSpaceCoordinatesFromReferenceSpace(double xi_1, double xi_2, double xi_3);
+    std::pair<Mat3, double> get_JacobianMatrixAndDeterminant(double xi_1, double xi_2, double xi_3);
 
   };
 
@@ -66,18 +106,19 @@ namespace PAMELA
    * \param xi_3
    * \return
    */
-  inline std::vector<double> Element<ELEMENTS::FAMILY::POLYHEDRON>::get_RealSpaceCoordinatesFromReferenceSpace(double xi_1, double xi_2, double xi_3)
+  template <ELEMENTS::TYPE elementType>
+  inline Vec3 ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, elementType>::get_RealSpaceCoordinatesFromReferenceSpace(double xi_1, double xi_2, double xi_3)
   {
 
-    std::vector<double> coordinate = { 0, 0, 0 };
-    std::vector<double> basis_function = get_BasisFunctions(xi_1, xi_2, xi_3);
+    Vec3 coordinate;
+    BasisFunctions basis_function = get_BasisFunctions(xi_1, xi_2, xi_3);
 
-    int nbVertices = static_cast<int>(m_vertexList.size());
-    for (auto i = 0; i != nbVertices; ++i)
+    for (auto i = 0; i != nVertex; ++i)
     {
-      coordinate[0] = coordinate[0] + m_vertexList[i]->get_coordinates().x * basis_function[i];
-      coordinate[1] = coordinate[1] + m_vertexList[i]->get_coordinates().y * basis_function[i];
-      coordinate[2] = coordinate[2] + m_vertexList[i]->get_coordinates().z * basis_function[i];
+      auto vertex = m_vertexList[i]->get_coordinates();
+      coordinate[0] = coordinate[0] + vertex.x * basis_function[i];
+      coordinate[1] = coordinate[1] + vertex.y * basis_function[i];
+      coordinate[2] = coordinate[2] + vertex.z * basis_function[i];
     }
 
     return coordinate;
@@ -92,65 +133,27 @@ namespace PAMELA
    * \param xi_3
    * \return
    */
-  inline std::pair<std::vector<std::vector<double>>, double> Element<ELEMENTS::FAMILY::POLYHEDRON>::get_JacobianMatrixAndDeterminant(double xi_1, double xi_2, double xi_3)
+  template <ELEMENTS::TYPE elementType>
+  inline std::pair<Mat3, double> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, elementType>::get_JacobianMatrixAndDeterminant(double xi_1, double xi_2, double xi_3)
   {
 
-    std::vector<std::vector<double>> basis_function_derivatives_matrix = get_BasisFunctionDerivatives(xi_1, xi_2, xi_3);
-    std::vector<std::vector<double>>matrix = { { 0, 0, 0 },{ 0, 0, 0 },{ 0, 0, 0 } };
+    BasisFunctionDerivatives basis_function_derivatives_matrix = get_BasisFunctionDerivatives(xi_1, xi_2, xi_3);
+    Mat3 matrix;
 
-    for (auto i = 0; i != 3; ++i)
+    for (auto j = 0; j != nVertex; ++j)
     {
-      for (auto j = 0; j != static_cast<int>(m_vertexList.size()); ++j)
+      auto vertex = m_vertexList[j]->get_coordinates();
+      for (auto i = 0; i != 3; ++i)
       {
-        matrix[0][i] = matrix[0][i] + m_vertexList[j]->get_coordinates().x * basis_function_derivatives_matrix[j][i];
-        matrix[1][i] = matrix[1][i] + m_vertexList[j]->get_coordinates().y * basis_function_derivatives_matrix[j][i];
-        matrix[2][i] = matrix[2][i] + m_vertexList[j]->get_coordinates().z * basis_function_derivatives_matrix[j][i];
+        matrix(0, i) = matrix(0, i) + vertex.x * basis_function_derivatives_matrix[j][i];
+        matrix(1, i) = matrix(1, i) + vertex.y * basis_function_derivatives_matrix[j][i];
+        matrix(2, i) = matrix(2, i) + vertex.z * basis_function_derivatives_matrix[j][i];
       }
     }
-    double determinant = matrix[0][0] * (matrix[1][1] * matrix[2][2] - matrix[2][1] * matrix[1][2])
-      - matrix[0][1] * (matrix[1][0] * matrix[2][2] - matrix[2][0] * matrix[1][2])
-      + matrix[0][2] * (matrix[1][0] * matrix[2][1] - matrix[2][0] * matrix[1][1]);
 
-
-    std::pair<std::vector<std::vector<double>>, double> result;
-    result.first = matrix;
-    result.second = determinant;
-
-    return result;
+    return std::make_pair(matrix, matrix.determinant());
   }
 
-  typedef Element<ELEMENTS::FAMILY::POLYHEDRON> Polyhedron;
-
-
-  template <ELEMENTS::TYPE elementType>
-  class ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, elementType> : public Element<ELEMENTS::FAMILY::POLYHEDRON>
-  {
-  public:
-
-    ElementSpe(int index, const std::vector<Point*>& vertexList) :Element(index, vertexList)
-    {
-      ELEMENTS::nVertex.at(static_cast<int>(m_vtkType));
-      ASSERT(vertexList.size() == static_cast<unsigned int>(ELEMENTS::nVertex.at(static_cast<int>(elementType))), "Vertex list size is not compatible with the element type");
-      ASSERT(ELEMENTS::TypeToFamily.at(static_cast<int>(elementType)) == m_family, "Type not compatible with family");
-      m_vtkType = elementType;
-    }
-
-    //Actions
-    std::vector<Polygon*> CreateFaces() override;
-
-    //Geometry
-    double get_Volume() override;
-    std::vector<double> get_centroidCoordinates() override;
-
-
-  private:
-
-    //Functions
-    std::vector <double> get_BasisFunctions(double xi_1, double xi_2, double xi_3) override;
-    std::vector<std::vector<double>> get_BasisFunctionDerivatives(double xi_1, double xi_2, double xi_3) override;
-
-  };
-
 
 
 
@@ -169,45 +172,25 @@ namespace PAMELA
   * \return
   */
   template <>
-  inline std::vector<double> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_TETRA>::get_centroidCoordinates()
+  inline Vec3 ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_TETRA>::get_centroidCoordinates()
   {
     return get_RealSpaceCoordinatesFromReferenceSpace(1. / 4., 1. / 4., 1. / 4.);
   }
 
 
   template <>
-  inline std::vector<double> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_TETRA>::get_BasisFunctions(double xi_1, double xi_2, double xi_3)
+  inline ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_TETRA>::BasisFunctions ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_TETRA>::get_BasisFunctions(double xi_1, double xi_2, double xi_3)
   {
-    std::vector<double> basis_functions;
-
-    basis_functions.push_back(1 - xi_1 - xi_2 - xi_3);
-    basis_functions.push_back(xi_1);
-    basis_functions.push_back(xi_2);
-    basis_functions.push_back(xi_3);
-
-
-    return basis_functions;
+    return {{ 1 - xi_1 - xi_2 - xi_3, xi_1, xi_2, xi_3 }};
   }
 
   template <>
-  inline std::vector<std::vector<double>> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_TETRA>::get_BasisFunctionDerivatives(double xi_1, double xi_2, double xi_3)
+  inline ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_TETRA>::BasisFunctionDerivatives ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_TETRA>::get_BasisFunctionDerivatives(double xi_1, double xi_2, double xi_3)
   {
                 utils::pamela_unused(xi_1);
                 utils::pamela_unused(xi_2);
                 utils::pamela_unused(xi_3);
-    std::vector<double> row;
-    std::vector<std::vector<double>> matrix;
-
-    row = { -1, -1, -1 };
-    matrix.push_back(row);
-    row = { 1, 0, 0 };
-    matrix.push_back(row);
-    row = { 0, 1, 0 };
-    matrix.push_back(row);
-    row = { 0, 0, 1 };
-    matrix.push_back(row);
-
-    return matrix;
+    return {{ {{ -1, -1, -1 }}, {{ 1, 0, 0 }}, {{ 0, 1, 0 }}, {{ 0, 0, 1 }} }};
 
   }
 
@@ -218,31 +201,15 @@ namespace PAMELA
   inline double ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_HEXAHEDRON>::get_Volume()
   {
 
-    std::vector<double> Gauss_weight(8);
-    Gauss_weight[0] = 1.;
-    Gauss_weight[1] = 1.;
-    Gauss_weight[2] = 1.;
-    Gauss_weight[3] = 1.;
-    Gauss_weight[4] = 1.;
-    Gauss_weight[5] = 1.;
-    Gauss_weight[6] = 1.;
-    Gauss_weight[7] = 1.;
-
-    double alpha = 1. / sqrt(3);
-    std::vector<std::vector<double>>  Gauss_point(8);
-    Gauss_point[0] = { -alpha, -alpha, -alpha };
-    Gauss_point[1] = { alpha, -alpha, -alpha };
-    Gauss_point[2] = { alpha, alpha, -alpha };
-    Gauss_point[3] = { -alpha, alpha, -alpha };
-    Gauss_point[4] = { -alpha, -alpha, alpha };
-    Gauss_point[5] = { alpha, -alpha, alpha };
-    Gauss_point[6] = { alpha, alpha, alpha };
-    Gauss_point[7] = { -alpha, alpha, alpha };
+    //Gauss weights are all 1
+    const double alpha = 1. / std::sqrt(3.);
+    const double Gauss_point[8][3] = { { -alpha, -alpha, -alpha },{ alpha, -alpha, -alpha },{ alpha, alpha, -alpha },{ -alpha, alpha, -alpha },
+                                       { -alpha, -alpha, alpha },{ alpha, -alpha, alpha },{ alpha, alpha, alpha },{ -alpha, alpha, alpha } };
 
     double volume = 0;
     for (auto i = 0; i != 8; ++i)
     {
-      volume = volume + Gauss_weight[i] * get_JacobianMatrixAndDeterminant(Gauss_point[i][0], Gauss_point[i][1], Gauss_point[i][2]).second;
+      volume = volume + get_JacobianMatrixAndDeterminant(Gauss_point[i][0], Gauss_point[i][1], Gauss_point[i][2]).second;
     }
 
     return std::fabs(volume);
@@ -254,7 +221,7 @@ namespace PAMELA
   * \return
   */
   template <>
-  inline std::vector<double> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_HEXAHEDRON>::get_centroidCoordinates()
+  inline Vec3 ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_HEXAHEDRON>::get_centroidCoordinates()
   {
     return get_RealSpaceCoordinatesFromReferenceSpace(0., 0., 0.);
   }
@@ -268,21 +235,17 @@ namespace PAMELA
    * \return
    */
   template <>
-  inline std::vector<double> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_HEXAHEDRON>::get_BasisFunctions(double xi_1, double xi_2, double xi_3)
+  inline ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_HEXAHEDRON>::BasisFunctions ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_HEXAHEDRON>::get_BasisFunctions(double xi_1, double xi_2, double xi_3)
   {
-    std::vector<double> basis_functions;
-
-    basis_functions.push_back(1. / 8. * (1 - xi_1) * (1 - xi_2) * (1 - xi_3));
-    basis_functions.push_back(1. / 8. * (1 + xi_1) * (1 - xi_2) * (1 - xi_3));
-    basis_functions.push_back(1. / 8. * (1 + xi_1) * (1 + xi_2) * (1 - xi_3));
-    basis_functions.push_back(1. / 8. * (1 - xi_1) * (1 + xi_2) * (1 - xi_3));
-    basis_functions.push_back(1. / 8. * (1 - xi_1) * (1 - xi_2) * (1 + xi_3));
-    basis_functions.push_back(1. / 8. * (1 + xi_1) * (1 - xi_2) * (1 + xi_3));
-    basis_functions.push_back(1. / 8. * (1 + xi_1) * (1 + xi_2) * (1 + xi_3));
-    basis_functions.push_back(1. / 8. * (1 - xi_1) * (1 + xi_2) * (1 + xi_3));
-
-
-    return basis_functions;
+    return {{
+      1. / 8. * (1 - xi_1) * (1 - xi_2) * (1 - xi_3),
+      1. / 8. * (1 + xi_1) * (1 - xi_2) * (1 - xi_3),
+      1. / 8. * (1 + xi_1) * (1 + xi_2) * (1 - xi_3),
+      1. / 8. * (1 - xi_1) * (1 + xi_2) * (1 - xi_3),
+      1. / 8. * (1 - xi_1) * (1 - xi_2) * (1 + xi_3),
+      1. / 8. * (1 + xi_1) * (1 - xi_2) * (1 + xi_3),
+      1. / 8. * (1 + xi_1) * (1 + xi_2) * (1 + xi_3),
+      1. / 8. * (1 - xi_1) * (1 + xi_2) * (1 + xi_3) }};
   }
 
   /**
@@ -293,29 +256,17 @@ namespace PAMELA
    * \return
    */
   template <>
-  inline std::vector<std::vector<double>> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_HEXAHEDRON>::get_BasisFunctionDerivatives(double xi_1, double xi_2, double xi_3)
+  inline ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_HEXAHEDRON>::BasisFunctionDerivatives ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_HEXAHEDRON>::get_BasisFunctionDerivatives(double xi_1, double xi_2, double xi_3)
   {
-    std::vector<double> row;
-    std::vector<std::vector<double>> matrix;
-
-    row = { -1. / 8. * (1 - xi_2) * (1 - xi_3) , -1. / 8. * (1 - xi_1) * (1 - xi_3) , -1. / 8. * (1 - xi_1) * (1 - xi_2) };
-    matrix.push_back(row);
-    row = { 1. / 8. * (1 - xi_2) * (1 - xi_3) , -1. / 8. * (1 + xi_1) * (1 - xi_3) , -1. / 8. * (1 + xi_1) * (1 - xi_2) };
-    matrix.push_back(row);
-    row = { 1. / 8. * (1 + xi_2) * (1 - xi_3) , 1. / 8. * (1 + xi_1) * (1 - xi_3) , -1. / 8. * (1 + xi_1) * (1 + xi_2) };
-    matrix.push_back(row);
-    row = { -1. / 8. * (1 + xi_2) * (1 - xi_3) , 1. / 8. * (1 - xi_1) * (1 - xi_3) , -1. / 8. * (1 - xi_1) * (1 + xi_2) };
-    matrix.push_back(row);
-    row = { -1. / 8. * (1 - xi_2) * (1 + xi_3) , -1. / 8. * (1 - xi_1) * (1 + xi_3) , 1. / 8. * (1 - xi_1) * (1 - xi_2) };
-    matrix.push_back(row);
-    row = { 1. / 8. * (1 - xi_2) * (1 + xi_3) , -1. / 8. * (1 + xi_1) * (1 + xi_3) , 1. / 8. * (1 + xi_1) * (1 - xi_2) };
-    matrix.push_back(row);
-    row = { 1. / 8. * (1 + xi_2) * (1 + xi_3) , 1. / 8. * (1 + xi_1) * (1 + xi_3) , 1. / 8. * (1 + xi_1) * (1 + xi_2) };
-    matrix.push_back(row);
-    row = { -1. / 8. * (1 + xi_2) * (1 + xi_3) , 1. / 8. * (1 - xi_1) * (1 + xi_3) , 1. / 8. * (1 - xi_1) * (1 + xi_2) };
-    matrix.push_back(row);
-
-    return matrix;
+    return {{
+      {{ -1. / 8. * (1 - xi_2) * (1 - xi_3) , -1. / 8. * (1 - xi_1) * (1 - xi_3) , -1. / 8. * (1 - xi_1) * (1 - xi_2) }},
+      {{ 1. / 8. * (1 - xi_2) * (1 - xi_3) , -1. / 8. * (1 + xi_1) * (1 - xi_3) , -1. / 8. * (1 + xi_1) * (1 - xi_2) }},
+      {{ 1. / 8. * (1 + xi_2) * (1 - xi_3) , 1. / 8. * (1 + xi_1) * (1 - xi_3) , -1. / 8. * (1 + xi_1) * (1 + xi_2) }},
+      {{ -1. / 8. * (1 + xi_2) * (1 - xi_3) , 1. / 8. * (1 - xi_1) * (1 - xi_3) , -1. / 8. * (1 - xi_1) * (1 + xi_2) }},
+      {{ -1. / 8. * (1 - xi_2) * (1 + xi_3) , -1. / 8. * (1 - xi_1) * (1 + xi_3) , 1. / 8. * (1 - xi_1) * (1 - xi_2) }},
+      {{ 1. / 8. * (1 - xi_2) * (1 + xi_3) , -1. / 8. * (1 + xi_1) * (1 + xi_3) , 1. / 8. * (1 + xi_1) * (1 - xi_2) }},
+      {{ 1. / 8. * (1 + xi_2) * (1 + xi_3) , 1. / 8. * (1 + xi_1) * (1 + xi_3) , 1. / 8. * (1 + xi_1) * (1 + xi_2) }},
+      {{ -1. / 8. * (1 + xi_2) * (1 + xi_3) , 1. / 8. * (1 - xi_1) * (1 + xi_3) , 1. / 8. * (1 - xi_1) * (1 + xi_2) }} }};
 
   }
 
@@ -336,10 +287,10 @@ namespace PAMELA
   * \return
   */
   template <>
-  inline std::vector<double> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_WEDGE>::get_centroidCoordinates()
+  inline Vec3 ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_WEDGE>::get_centroidCoordinates()
   {
     LOGERROR("NOT SUPPORTED YET");
-    return{ 0,0,0,0,0,0 };  //TODO
+    return Vec3();  //TODO
   }
 
 
@@ -351,13 +302,13 @@ namespace PAMELA
   * \return
   */
   template <>
-  inline std::vector<double> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_WEDGE>::get_BasisFunctions(double xi_1, double xi_2, double xi_3)
+  inline ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_WEDGE>::BasisFunctions ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_WEDGE>::get_BasisFunctions(double xi_1, double xi_2, double xi_3)
   {
                 utils::pamela_unused(xi_1);
                 utils::pamela_unused(xi_2);
                 utils::pamela_unused(xi_3);
     LOGERROR("NOT SUPPORTED YET");
-    return{ 0,0,0,0,0,0 };  //TODO
+    return BasisFunctions();  //TODO
   }
 
   /**
@@ -368,15 +319,13 @@ namespace PAMELA
   * \return
   */
   template <>
-  inline std::vector<std::vector<double>> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_WEDGE>::get_BasisFunctionDerivatives(double xi_1, double xi_2, double xi_3)
+  inline ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_WEDGE>::BasisFunctionDerivatives ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_WEDGE>::get_BasisFunctionDerivatives(double xi_1, double xi_2, double xi_3)
   {
                 utils::pamela_unused(xi_1);
                 utils::pamela_unused(xi_2);
                 utils::pamela_unused(xi_3);
-    std::vector<double> row;
-    std::vector<std::vector<double>> matrix;
     LOGERROR("NOT SUPPORTED YET");
-    return matrix;			//TODO
+    return BasisFunctionDerivatives();			//TODO
 
   }
 
@@ -396,10 +345,10 @@ namespace PAMELA
   * \return
   */
   template <>
-  inline std::vector<double> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_PYRAMID>::get_centroidCoordinates()
+  inline Vec3 ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_PYRAMID>::get_centroidCoordinates()
   {
     LOGERROR("NOT SUPPORTED YET");
-    return{ 0,0,0,0,0 };  //TODO
+    return Vec3();  //TODO
   }
 
 
@@ -411,13 +360,13 @@ namespace PAMELA
   * \return
   */
   template <>
-  inline std::vector<double> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_PYRAMID>::get_BasisFunctions(double xi_1, double xi_2, double xi_3)
+  inline ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_PYRAMID>::BasisFunctions ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_PYRAMID>::get_BasisFunctions(double xi_1, double xi_2, double xi_3)
   {
                 utils::pamela_unused(xi_1);
                 utils::pamela_unused(xi_2);
                 utils::pamela_unused(xi_3);
     LOGERROR("NOT SUPPORTED YET");
-    return{ 0,0,0,0,0 };  //TODO
+    return BasisFunctions();  //TODO
   }
 
   /**
@@ -428,22 +377,20 @@ namespace PAMELA
   * \return
   */
   template <>
-  inline std::vector<std::vector<double>> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_PYRAMID>::get_BasisFunctionDerivatives(double xi_1, double xi_2, double xi_3)
+  inline ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_PYRAMID>::BasisFunctionDerivatives ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_PYRAMID>::get_BasisFunctionDerivatives(double xi_1, double xi_2, double xi_3)
   {
                 utils::pamela_unused(xi_1);
                 utils::pamela_unused(xi_2);
                 utils::pamela_unused(xi_3);
-    std::vector<double> row;
-    std::vector<std::vector<double>> matrix;
     LOGERROR("NOT SUPPORTED YET");
-    return matrix;			//TODO
+    return BasisFunctionDerivatives();			//TODO
 
   }
 
 
   //////// VTK_TETRA
   template <>
-  inline std::vector<Polygon*> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_TETRA >::CreateFaces()
+  inline std::vector<Polygon*> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_TETRA >::CreateFaces(ElementArena* arena)
   {
     std::vector<Point*> vertexTemp = { nullptr,nullptr,nullptr };
     std::vector<Polygon*> faceTemp;
@@ -452,28 +399,28 @@ namespace PAMELA
     vertexTemp[0] = m_vertexList[0];
     vertexTemp[1] = m_vertexList[1];
     vertexTemp[2] = m_vertexList[2];
-    auto face0 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>(-1, vertexTemp);
+    auto face0 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>>(arena, -1, vertexTemp);
     faceTemp.push_back(face0);
 
     //Create face 1
     vertexTemp[0] = m_vertexList[0];
     vertexTemp[1] = m_vertexList[1];
     vertexTemp[2] = m_vertexList[3];
-    auto face1 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>(-1, vertexTemp);
+    auto face1 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>>(arena, -1, vertexTemp);
     faceTemp.push_back(face1);
 
     //Create face 2
     vertexTemp[0] = m_vertexList[1];
     vertexTemp[1] = m_vertexList[2];
     vertexTemp[2] = m_vertexList[3];
-    auto face2 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>(-1, vertexTemp);
+    auto face2 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>>(arena, -1, vertexTemp);
     faceTemp.push_back(face2);
 
     //Create face 3
     vertexTemp[0] = m_vertexList[2];
     vertexTemp[1] = m_vertexList[0];
     vertexTemp[2] = m_vertexList[3];
-    auto face3 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>(-1, vertexTemp);
+    auto face3 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>>(arena, -1, vertexTemp);
     faceTemp.push_back(face3);
 
     return faceTemp;
@@ -481,7 +428,7 @@ namespace PAMELA
 
   //////// VTK_HEXA
   template <>
-  inline std::vector<Polygon*> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_HEXAHEDRON >::CreateFaces()
+  inline std::vector<Polygon*> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_HEXAHEDRON >::CreateFaces(ElementArena* arena)
   {
     std::vector<Point*> vertexTemp = { nullptr,nullptr,nullptr,nullptr };
     std::vector<Polygon*> faceTemp;
@@ -491,7 +438,7 @@ namespace PAMELA
     vertexTemp[1] = m_vertexList[1];
     vertexTemp[2] = m_vertexList[5];
     vertexTemp[3] = m_vertexList[4];
-    auto face0 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>(-1, vertexTemp);
+    auto face0 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>>(arena, -1, vertexTemp);
     faceTemp.push_back(face0);
 
     //Create face 1
@@ -499,7 +446,7 @@ namespace PAMELA
     vertexTemp[1] = m_vertexList[2];
     vertexTemp[2] = m_vertexList[6];
     vertexTemp[3] = m_vertexList[5];
-    auto face1 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>(-1, vertexTemp);
+    auto face1 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>>(arena, -1, vertexTemp);
     faceTemp.push_back(face1);
 
     //Create face 2
@@ -507,7 +454,7 @@ namespace PAMELA
     vertexTemp[1] = m_vertexList[3];
     vertexTemp[2] = m_vertexList[7];
     vertexTemp[3] = m_vertexList[6];
-    auto face2 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>(-1, vertexTemp);
+    auto face2 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>>(arena, -1, vertexTemp);
     faceTemp.push_back(face2);
 
     //Create face 3
@@ -515,7 +462,7 @@ namespace PAMELA
     vertexTemp[1] = m_vertexList[0];
     vertexTemp[2] = m_vertexList[4];
     vertexTemp[3] = m_vertexList[7];
-    auto face3 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>(-1, vertexTemp);
+    auto face3 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>>(arena, -1, vertexTemp);
     faceTemp.push_back(face3);
 
     //Create face 4
@@ -523,7 +470,7 @@ namespace PAMELA
     vertexTemp[1] = m_vertexList[5];
     vertexTemp[2] = m_vertexList[6];
     vertexTemp[3] = m_vertexList[7];
-    auto face4 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>(-1, vertexTemp);
+    auto face4 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>>(arena, -1, vertexTemp);
     faceTemp.push_back(face4);
 
     //Create face 5
@@ -531,7 +478,7 @@ namespace PAMELA
     vertexTemp[1] = m_vertexList[1];
     vertexTemp[2] = m_vertexList[2];
     vertexTemp[3] = m_vertexList[3];
-    auto face5 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>(-1, vertexTemp);
+    auto face5 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>>(arena, -1, vertexTemp);
     faceTemp.push_back(face5);
 
     return faceTemp;
@@ -540,7 +487,7 @@ namespace PAMELA
 
   //VTK_WEDGE
   template <>
-  inline std::vector<Polygon*> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_WEDGE>::CreateFaces()
+  inline std::vector<Polygon*> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_WEDGE>::CreateFaces(ElementArena* arena)
   {
     std::vector<Point*> vertexTemp3 = { nullptr,nullptr,nullptr };
     std::vector<Point*> vertexTemp4 = { nullptr,nullptr,nullptr,nullptr };
@@ -550,14 +497,14 @@ namespace PAMELA
     vertexTemp3[0] = m_vertexList[0];
     vertexTemp3[1] = m_vertexList[1];
     vertexTemp3[2] = m_vertexList[2];
-    auto face0 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>(-1, vertexTemp3);
+    auto face0 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>>(arena, -1, vertexTemp3);
     faceTemp.push_back(face0);
 
     //Create face 1
     vertexTemp3[0] = m_vertexList[3];
     vertexTemp3[1] = m_vertexList[4];
     vertexTemp3[2] = m_vertexList[5];
-    auto face1 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>(-1, vertexTemp3);
+    auto face1 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>>(arena, -1, vertexTemp3);
     faceTemp.push_back(face1);
 
     //Create face 2
@@ -565,7 +512,7 @@ namespace PAMELA
     vertexTemp4[1] = m_vertexList[1];
     vertexTemp4[2] = m_vertexList[4];
     vertexTemp4[3] = m_vertexList[3];
-    auto face2 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>(-1, vertexTemp4);
+    auto face2 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>>(arena, -1, vertexTemp4);
     faceTemp.push_back(face2);
 
     //Create face 3
@@ -573,7 +520,7 @@ namespace PAMELA
     vertexTemp4[1] = m_vertexList[0];
     vertexTemp4[2] = m_vertexList[2];
     vertexTemp4[3] = m_vertexList[5];
-    auto face3 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>(-1, vertexTemp4);
+    auto face3 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>>(arena, -1, vertexTemp4);
     faceTemp.push_back(face3);
 
     //Create face 4
@@ -581,14 +528,14 @@ namespace PAMELA
     vertexTemp4[1] = m_vertexList[1];
     vertexTemp4[2] = m_vertexList[2];
     vertexTemp4[3] = m_vertexList[5];
-    auto face4 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>(-1, vertexTemp4);
+    auto face4 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>>(arena, -1, vertexTemp4);
     faceTemp.push_back(face4);
 
     return faceTemp;
   }
 
   template <>
-  inline std::vector<Polygon*> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_PYRAMID >::CreateFaces()
+  inline std::vector<Polygon*> ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::TYPE::VTK_PYRAMID >::CreateFaces(ElementArena* arena)
   {
     std::vector<Point*> vertexTemp3 = { nullptr,nullptr,nullptr };
     std::vector<Point*> vertexTemp4 = { nullptr,nullptr,nullptr,nullptr };
@@ -598,28 +545,28 @@ namespace PAMELA
     vertexTemp3[0] = m_vertexList[3];
     vertexTemp3[1] = m_vertexList[0];
     vertexTemp3[2] = m_vertexList[4];
-    auto face0 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>(-1, vertexTemp3);
+    auto face0 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>>(arena, -1, vertexTemp3);
     faceTemp.push_back(face0);
 
     //Create face 1
     vertexTemp3[0] = m_vertexList[0];
     vertexTemp3[1] = m_vertexList[1];
     vertexTemp3[2] = m_vertexList[4];
-    auto face1 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>(-1, vertexTemp3);
+    auto face1 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>>(arena, -1, vertexTemp3);
     faceTemp.push_back(face1);
 
     //Create face 2
     vertexTemp3[0] = m_vertexList[4];
     vertexTemp3[1] = m_vertexList[1];
     vertexTemp3[2] = m_vertexList[2];
-    auto face2 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>(-1, vertexTemp3);
+    auto face2 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>>(arena, -1, vertexTemp3);
     faceTemp.push_back(face2);
 
     //Create face 3
     vertexTemp3[0] = m_vertexList[2];
     vertexTemp3[1] = m_vertexList[3];
     vertexTemp3[2] = m_vertexList[4];
-    auto face3 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>(-1, vertexTemp3);
+    auto face3 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_TRIANGLE>>(arena, -1, vertexTemp3);
     faceTemp.push_back(face3);
 
     //Create face 4
@@ -627,7 +574,7 @@ namespace PAMELA
     vertexTemp4[1] = m_vertexList[1];
     vertexTemp4[2] = m_vertexList[2];
     vertexTemp4[3] = m_vertexList[3];
-    auto face4 = new ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>(-1, vertexTemp4);
+    auto face4 = ElementArena::create<ElementSpe<ELEMENTS::FAMILY::POLYGON, ELEMENTS::TYPE::VTK_QUAD>>(arena, -1, vertexTemp4);
     faceTemp.push_back(face4);
 
     return faceTemp;
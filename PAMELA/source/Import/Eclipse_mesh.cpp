@@ -1249,22 +1249,18 @@ namespace PAMELA
           }
 
           //Create line and point groups
-          auto polyhedron_collection = mesh->get_PolyhedronCollection();
+          auto& geometry = mesh->get_PolyhedronGeometry();
           for (auto itw=m_Wells.begin(); itw != m_Wells.end();++itw)
           {
             std::vector<Point*> vecpoint;
             auto well = itw->second;
             auto hcindex = well->head_cell_index;
-            auto itpol = polyhedron_collection->begin_owned() + hcindex;
-            auto xyz = (*itpol)->get_centroidCoordinates();
-            vecpoint.push_back(ElementFactory::makePoint(ELEMENTS::TYPE::VTK_VERTEX, -1, xyz[0], xyz[1], 0));
+            vecpoint.push_back(ElementFactory::makePoint(ELEMENTS::TYPE::VTK_VERTEX, -1, geometry.x[hcindex], geometry.y[hcindex], 0));
             auto comps = well->completions;
             for (unsigned int ic = 0; ic != well->nb_completions; ++ic)
             {
               auto cell_index = comps[ic].hosting_cell_index;
-              auto itpol2 = polyhedron_collection->begin_owned() + cell_index;
-              auto xyz2 = (*itpol2)->get_centroidCoordinates();
-              vecpoint.push_back(ElementFactory::makePoint(ELEMENTS::TYPE::VTK_VERTEX, -1, xyz2[0], xyz2[1], xyz2[2]));
+              vecpoint.push_back(ElementFactory::makePoint(ELEMENTS::TYPE::VTK_VERTEX, -1, geometry.x[cell_index], geometry.y[cell_index], geometry.z[cell_index]));
             }
             mesh->AddImplicitLine(ELEMENTS::TYPE::VTK_LINE, itw->first, vecpoint);
             mesh->get_ImplicitLineCollection()->MakeActiveGroup(itw->first);
@@ -289,10 +289,11 @@ namespace PAMELA
 		srand(0);
 		for (auto it = Pointcollection.begin(); it != Pointcollection.end(); ++it)
 		{
-			auto& coord = (*it)->get_coordinates();
+			auto coord = (*it)->get_coordinates();
 			coord.x = coord.x + (rand() % 10 + 1)*minDx*alpha / 10;
 			coord.y = coord.y + (rand() % 10 + 1)*minDy*alpha / 10;
 			coord.z = coord.z + (rand() % 10 + 1)*minDz*alpha / 10;
+			(*it)->set_coordinates(coord);
 		}
 
 		//Realign point on boundaries
@@ -303,7 +304,9 @@ namespace PAMELA
 			auto& vertexList = (*it)->get_vertexList();
 			for (auto it2 = vertexList.begin(); it2 != vertexList.end(); ++it2)
 			{
-				(*it2)->get_coordinates().y = m_Lymax;
+				auto coord = (*it2)->get_coordinates();
+				coord.y = m_Lymax;
+				(*it2)->set_coordinates(coord);
 			}
 		}
 		//--South
@@ -313,7 +316,9 @@ namespace PAMELA
 			auto& vertexList = (*it)->get_vertexList();
 			for (auto it2 = vertexList.begin(); it2 != vertexList.end(); ++it2)
 			{
-				 (*it2)->get_coordinates().y = m_Lymin;
+				auto coord = (*it2)->get_coordinates();
+				coord.y = m_Lymin;
+				(*it2)->set_coordinates(coord);
 			}
 		}
 		//--East
@@ -323,7 +328,9 @@ namespace PAMELA
 			auto& vertexList = (*it)->get_vertexList();
 			for (auto it2 = vertexList.begin(); it2 != vertexList.end(); ++it2)
 			{
-				(*it2)->get_coordinates().x = m_Lxmax;
+				auto coord = (*it2)->get_coordinates();
+				coord.x = m_Lxmax;
+				(*it2)->set_coordinates(coord);
 			}
 		}
 		//--West
@@ -333,7 +340,9 @@ namespace PAMELA
 			auto& vertexList = (*it)->get_vertexList();
 			for (auto it2 = vertexList.begin(); it2 != vertexList.end(); ++it2)
 			{
-				(*it2)->get_coordinates().x = m_Lxmin;
+				auto coord = (*it2)->get_coordinates();
+				coord.x = m_Lxmin;
+				(*it2)->set_coordinates(coord);
 			}
 		}
 		//--Top
@@ -343,7 +352,9 @@ namespace PAMELA
 			auto& vertexList = (*it)->get_vertexList();
 			for (auto it2 = vertexList.begin(); it2 != vertexList.end(); ++it2)
 			{
-				(*it2)->get_coordinates().z = m_Lzmax;
+				auto coord = (*it2)->get_coordinates();
+				coord.z = m_Lzmax;
+				(*it2)->set_coordinates(coord);
 			}
 		}
 		//--Bottom
@@ -353,10 +364,14 @@ namespace PAMELA
 			auto& vertexList = (*it)->get_vertexList();
 			for (auto it2 = vertexList.begin(); it2 != vertexList.end(); ++it2)
 			{
-				(*it2)->get_coordinates().z = m_Lzmin;
+				auto coord = (*it2)->get_coordinates();
+				coord.z = m_Lzmin;
+				(*it2)->set_coordinates(coord);
 			}
 		}
 
+		InvalidateGeometry();
+
 		LOGINFO("*** Done...");
 	}
 
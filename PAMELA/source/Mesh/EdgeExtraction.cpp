@@ -0,0 +1,154 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#include "Mesh/EdgeExtraction.hpp"
+#include "Elements/EdgeTable.hpp"
+#include "Utils/ParallelFor.hpp"
+#include "Utils/Assert.hpp"
+
+namespace PAMELA
+{
+
+	namespace
+	{
+		typedef CSRMatrix::offset_type offset_type;
+
+		//Existing edges have ordinals [0,nExistingEdge), the local edges of the cells follow in order
+		struct EdgeTuple
+		{
+			std::uint64_t key;
+			offset_type ordinal;
+
+			bool operator<(const EdgeTuple& rhs) const { return (key < rhs.key) || ((key == rhs.key) && (ordinal < rhs.ordinal)); }
+		};
+
+		const std::ptrdiff_t chunkSize = 1 << 14;
+	}
+
+	void ExtractEdges(const CellConnectivity& cells, const std::vector<std::uint64_t>& existingEdges, EdgeExtraction& extraction)
+	{
+		const size_t nCell = cells.size();
+		const size_t nExisting = existingEdges.size();
+		extraction.nExistingEdge = nExisting;
+
+		//Edge tables indexed by vtk type
+		const int nType = static_cast<int>(ELEMENTS::TYPE::VTK_PYRAMID) + 1;
+		ELEMENTS::EdgeTable tables[nType];
+		for (int type = 0; type != nType; ++type)
+		{
+			tables[type] = ELEMENTS::edgeTableOf(static_cast<ELEMENTS::TYPE>(type));
+		}
+
+		//Local edges of each cell
+		auto& cellToEdgePtr = extraction.cellToEdgePtr;
+		cellToEdgePtr.assign(nCell + 1, 0);
+		for (size_t i = 0; i != nCell; ++i)
+		{
+			auto type = static_cast<int>(cells.get_vtkType(i));
+			ASSERT((type >= 0) && (type < nType) && (tables[type].nEdge > 0), "Cell is not a polyhedron");
+			cellToEdgePtr[i + 1] = cellToEdgePtr[i] + tables[type].nEdge;
+		}
+		const size_t nEmitted = static_cast<size_t>(cellToEdgePtr[nCell]);
+		const size_t nTuple = nExisting + nEmitted;
+
+		//Emit
+		std::vector<EdgeTuple> tuples(nTuple);
+		utils::parallel_for(0, static_cast<std::ptrdiff_t>(nExisting), [&](std::ptrdiff_t i)
+		{
+			tuples[i].key = existingEdges[i];
+			tuples[i].ordinal = static_cast<offset_type>(i);
+		});
+		utils::parallel_for(0, static_cast<std::ptrdiff_t>(nCell), [&](std::ptrdiff_t i)
+		{
+			const auto& table = tables[static_cast<int>(cells.get_vtkType(i))];
+			auto vertices = cells.begin(i);
+			for (int e = 0; e != table.nEdge; ++e)
+			{
+				auto v0 = vertices[table.vertex[e][0]];
+				auto v1 = vertices[table.vertex[e][1]];
+				ASSERT((v0 != CellConnectivity::invalid_index) && (v1 != CellConnectivity::invalid_index), "Vertex is not stored on this partition");
+				auto ordinal = nExisting + static_cast<size_t>(cellToEdgePtr[i] + e);
+				tuples[ordinal].key = edgeKey(v0, v1);
+				tuples[ordinal].ordinal = static_cast<offset_type>(ordinal);
+			}
+		});
+
+		//Sort, equal keys are contiguous and the first one of a run is an existing edge or the first occurrence
+		utils::parallel_sort(tuples.begin(), tuples.end(), [](const EdgeTuple& lhs, const EdgeTuple& rhs) { return lhs < rhs; });
+		std::vector<int> newEdgeRank(nEmitted + 1, 0);
+		utils::parallel_for(0, static_cast<std::ptrdiff_t>(nTuple), [&](std::ptrdiff_t t)
+		{
+			bool isFirst = (t == 0) || (tuples[t].key != tuples[t - 1].key);
+			if (isFirst && (tuples[t].ordinal >= static_cast<offset_type>(nExisting)))
+			{
+				newEdgeRank[tuples[t].ordinal - nExisting] = 1;
+			}
+		});
+
+		//Number the new edges in order of first occurrence
+		int nNew = 0;
+		for (size_t e = 0; e != nEmitted; ++e)
+		{
+			auto isNew = newEdgeRank[e];
+			newEdgeRank[e] = nNew;
+			nNew += isNew;
+		}
+		newEdgeRank[nEmitted] = nNew;
+		extraction.newEdgeCell.resize(nNew);
+		extraction.newEdgeLocal.resize(nNew);
+
+		//Each chunk handles the runs starting in it
+		auto& cellToEdge = extraction.cellToEdge;
+		cellToEdge.resize(nEmitted);
+		const std::ptrdiff_t nChunk = (static_cast<std::ptrdiff_t>(nTuple) + chunkSize - 1) / chunkSize;
+		utils::parallel_for(0, nChunk, [&](std::ptrdiff_t chunk)
+		{
+			const size_t first = static_cast<size_t>(chunk * chunkSize);
+			const size_t last = std::min(nTuple, first + chunkSize);
+			size_t t = first;
+			while ((t < last) && (t != 0) && (tuples[t].key == tuples[t - 1].key))
+			{
+				++t;
+			}
+			while (t < last)
+			{
+				auto ordinal = tuples[t].ordinal;
+				auto edge = (ordinal < static_cast<offset_type>(nExisting)) ? static_cast<int>(ordinal) : static_cast<int>(nExisting) + newEdgeRank[ordinal - nExisting];
+				size_t end = t;
+				for (; (end < nTuple) && (tuples[end].key == tuples[t].key); ++end)
+				{
+					if (tuples[end].ordinal >= static_cast<offset_type>(nExisting))
+					{
+						cellToEdge[tuples[end].ordinal - nExisting] = edge;
+					}
+				}
+				t = end;
+			}
+		});
+
+		//First occurrence of the new edges
+		utils::parallel_for(0, static_cast<std::ptrdiff_t>(nCell), [&](std::ptrdiff_t i)
+		{
+			for (offset_type e = cellToEdgePtr[i]; e != cellToEdgePtr[i + 1]; ++e)
+			{
+				if (newEdgeRank[e + 1] != newEdgeRank[e])
+				{
+					extraction.newEdgeCell[newEdgeRank[e]] = static_cast<int>(i);
+					extraction.newEdgeLocal[newEdgeRank[e]] = static_cast<int>(e - cellToEdgePtr[i]);
+				}
+			}
+		});
+	}
+
+}
@@ -0,0 +1,63 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include "Collection/CellConnectivity.hpp"
+#include "Adjacency/CSRMatrix.hpp"
+
+namespace PAMELA
+{
+
+	//Canonical key of an edge from the indices of its two vertices
+	inline std::uint64_t edgeKey(std::uint32_t v0, std::uint32_t v1)
+	{
+		return (static_cast<std::uint64_t>(std::min(v0, v1)) << 32) | std::max(v0, v1);
+	}
+
+	//Key of an existing edge that matches no cell edge
+	constexpr std::uint64_t invalidEdgeKey = std::numeric_limits<std::uint64_t>::max();
+
+	/**
+	 * \brief Unique edges of a set of cells with the cell to edge incidence.
+	 * Edges matching an existing edge key keep that index, new edges follow in order of first appearance
+	 * when cells are visited in order and their edges in local edge order.
+	 */
+	struct EdgeExtraction
+	{
+		size_t nExistingEdge = 0;
+
+		//Cell and local edge of the first occurrence of each new edge
+		std::vector<int> newEdgeCell;
+		std::vector<int> newEdgeLocal;
+
+		//Cell to edge, row i holds the edges of cell i in local edge order. Offsets are 64-bit as hexahedra have 12 edges
+		std::vector<CSRMatrix::offset_type> cellToEdgePtr;
+		std::vector<int> cellToEdge;
+
+		size_t size_new() const { return newEdgeCell.size(); }
+		size_t size() const { return nExistingEdge + newEdgeCell.size(); }
+	};
+
+	/**
+	 * \brief Extract the edges of the cells without creating line elements.
+	 * One (edge key, ordinal) pair is emitted per local edge from the edge tables, pairs are sorted in parallel
+	 * and equal keys are numbered together. Existing keys must use the point numbering of the cell connectivity.
+	 */
+	void ExtractEdges(const CellConnectivity& cells, const std::vector<std::uint64_t>& existingEdges, EdgeExtraction& extraction);
+
+}
@@ -0,0 +1,284 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#include "Mesh/FaceExtraction.hpp"
+#include <algorithm>
+#include <cstdint>
+#include "Elements/FaceKey.hpp"
+#include "Elements/FaceTable.hpp"
+#include "Utils/ParallelFor.hpp"
+#include "Utils/Assert.hpp"
+
+namespace PAMELA
+{
+
+	namespace
+	{
+		typedef CSRMatrix::offset_type offset_type;
+
+		//Existing faces have ordinals [0,nExistingFace), the local faces of the cells follow in order
+		struct FaceTuple
+		{
+			FaceKey key;
+			offset_type ordinal;
+
+			bool operator<(const FaceTuple& rhs) const { return (key < rhs.key) || ((key == rhs.key) && (ordinal < rhs.ordinal)); }
+		};
+
+		const std::ptrdiff_t chunkSize = 1 << 14;
+	}
+
+	void ExtractFaces(const CellConnectivity& cells, const CellConnectivity& existingFaces, FaceExtraction& extraction)
+	{
+		const size_t nCell = cells.size();
+		const size_t nExisting = existingFaces.size();
+		extraction.nExistingFace = nExisting;
+
+		//Face tables indexed by vtk type
+		const int nType = static_cast<int>(ELEMENTS::TYPE::VTK_PYRAMID) + 1;
+		ELEMENTS::FaceTable tables[nType];
+		for (int type = 0; type != nType; ++type)
+		{
+			tables[type] = ELEMENTS::faceTableOf(static_cast<ELEMENTS::TYPE>(type));
+		}
+
+		//Local faces of each cell
+		auto& cellToFacePtr = extraction.cellToFacePtr;
+		cellToFacePtr.assign(nCell + 1, 0);
+		for (size_t i = 0; i != nCell; ++i)
+		{
+			auto type = static_cast<int>(cells.get_vtkType(i));
+			ASSERT((type >= 0) && (type < nType) && (tables[type].nFace > 0), "Cell is not a polyhedron");
+			cellToFacePtr[i + 1] = cellToFacePtr[i] + tables[type].nFace;
+		}
+		const size_t nEmitted = static_cast<size_t>(cellToFacePtr[nCell]);
+		const size_t nTuple = nExisting + nEmitted;
+
+		//Emit
+		std::vector<FaceTuple> tuples(nTuple);
+		std::vector<int> emittedCell(nEmitted);
+		utils::parallel_for(0, static_cast<std::ptrdiff_t>(nExisting), [&](std::ptrdiff_t i)
+		{
+			auto n = static_cast<int>(existingFaces.nVertex(i));
+			ASSERT(n <= FaceKey::maxVertex, "Face has too many vertices");
+			tuples[i].key = FaceKey(existingFaces.begin(i), n);
+			tuples[i].ordinal = static_cast<offset_type>(i);
+		});
+		utils::parallel_for(0, static_cast<std::ptrdiff_t>(nCell), [&](std::ptrdiff_t i)
+		{
+			const auto& table = tables[static_cast<int>(cells.get_vtkType(i))];
+			auto vertices = cells.begin(i);
+			std::uint32_t faceVertices[FaceKey::maxVertex];
+			for (int f = 0; f != table.nFace; ++f)
+			{
+				for (int v = 0; v != table.nVertex[f]; ++v)
+				{
+					ASSERT(vertices[table.vertex[f][v]] != CellConnectivity::invalid_index, "Vertex is not stored on this partition");
+					faceVertices[v] = vertices[table.vertex[f][v]];
+				}
+				auto ordinal = nExisting + static_cast<size_t>(cellToFacePtr[i] + f);
+				tuples[ordinal].key = FaceKey(faceVertices, table.nVertex[f]);
+				tuples[ordinal].ordinal = static_cast<offset_type>(ordinal);
+				emittedCell[ordinal - nExisting] = static_cast<int>(i);
+			}
+		});
+
+		//Sort, equal keys are contiguous and the first one of a run is an existing face or the first occurrence
+		utils::parallel_sort(tuples.begin(), tuples.end(), [](const FaceTuple& lhs, const FaceTuple& rhs) { return lhs < rhs; });
+		std::vector<std::uint8_t> isFirst(nTuple);
+		std::vector<int> newFaceRank(nEmitted + 1, 0);
+		utils::parallel_for(0, static_cast<std::ptrdiff_t>(nTuple), [&](std::ptrdiff_t t)
+		{
+			isFirst[t] = (t == 0) || (tuples[t].key != tuples[t - 1].key);
+			if (isFirst[t] && (tuples[t].ordinal >= static_cast<offset_type>(nExisting)))
+			{
+				newFaceRank[tuples[t].ordinal - nExisting] = 1;
+			}
+		});
+
+		//Number the new faces in order of first occurrence
+		int nNew = 0;
+		for (size_t e = 0; e != nEmitted; ++e)
+		{
+			auto isNew = newFaceRank[e];
+			newFaceRank[e] = nNew;
+			nNew += isNew;
+		}
+		newFaceRank[nEmitted] = nNew;
+		extraction.newFaceCell.resize(nNew);
+		extraction.newFaceLocal.resize(nNew);
+		const size_t nFace = nExisting + static_cast<size_t>(nNew);
+
+		auto faceOf = [&](offset_type ordinal)
+		{
+			return (ordinal < static_cast<offset_type>(nExisting)) ? static_cast<int>(ordinal) : static_cast<int>(nExisting) + newFaceRank[ordinal - nExisting];
+		};
+
+		//Pair up: each chunk handles the runs starting in it
+		auto& cellToFace = extraction.cellToFace;
+		auto& faceToCellPtr = extraction.faceToCellPtr;
+		cellToFace.resize(nEmitted);
+		faceToCellPtr.assign(nFace + 1, 0);
+		const std::ptrdiff_t nChunk = (static_cast<std::ptrdiff_t>(nTuple) + chunkSize - 1) / chunkSize;
+		auto forEachRun = [&](std::ptrdiff_t chunk, auto&& function)
+		{
+			const size_t first = static_cast<size_t>(chunk * chunkSize);
+			const size_t last = std::min(nTuple, first + chunkSize);
+			for (size_t t = first; t < last; ++t)
+			{
+				if (isFirst[t])
+				{
+					size_t end = t + 1;
+					while ((end < nTuple) && !isFirst[end])
+					{
+						++end;
+					}
+					function(t, end);
+				}
+			}
+		};
+		utils::parallel_for(0, nChunk, [&](std::ptrdiff_t chunk)
+		{
+			forEachRun(chunk, [&](size_t begin, size_t end)
+			{
+				auto face = faceOf(tuples[begin].ordinal);
+				int nFaceCell = 0;
+				for (size_t t = begin; t != end; ++t)
+				{
+					auto ordinal = tuples[t].ordinal;
+					if (ordinal >= static_cast<offset_type>(nExisting))
+					{
+						cellToFace[ordinal - nExisting] = face;
+						++nFaceCell;
+					}
+				}
+				faceToCellPtr[face + 1] = nFaceCell;
+			});
+		});
+		//Boundary faces are found while accumulating
+		extraction.isBoundary.assign(nFace, false);
+		extraction.boundaryFaces.clear();
+		for (size_t f = 0; f != nFace; ++f)
+		{
+			if (faceToCellPtr[f + 1] == 1)
+			{
+				extraction.isBoundary[f] = true;
+				extraction.boundaryFaces.push_back(static_cast<int>(f));
+			}
+			faceToCellPtr[f + 1] += faceToCellPtr[f];
+		}
+
+		//Face to cell and first occurrence of the new faces
+		auto& faceToCell = extraction.faceToCell;
+		faceToCell.resize(nEmitted);
+		utils::parallel_for(0, static_cast<std::ptrdiff_t>(nCell), [&](std::ptrdiff_t i)
+		{
+			for (offset_type e = cellToFacePtr[i]; e != cellToFacePtr[i + 1]; ++e)
+			{
+				if (newFaceRank[e + 1] != newFaceRank[e])
+				{
+					extraction.newFaceCell[newFaceRank[e]] = static_cast<int>(i);
+					extraction.newFaceLocal[newFaceRank[e]] = static_cast<int>(e - cellToFacePtr[i]);
+				}
+			}
+		});
+		utils::parallel_for(0, nChunk, [&](std::ptrdiff_t chunk)
+		{
+			forEachRun(chunk, [&](size_t begin, size_t end)
+			{
+				auto position = faceToCellPtr[faceOf(tuples[begin].ordinal)];
+				for (size_t t = begin; t != end; ++t)
+				{
+					auto ordinal = tuples[t].ordinal;
+					if (ordinal >= static_cast<offset_type>(nExisting))
+					{
+						//Local faces are emitted cell by cell, ordinals sorted within a run give sorted cells
+						faceToCell[position++] = emittedCell[ordinal - nExisting];
+					}
+				}
+			});
+		});
+	}
+
+	size_t MoveBoundaryFacesFirst(FaceExtraction& extraction)
+	{
+		const size_t nExisting = extraction.nExistingFace;
+		const size_t nNew = extraction.size_new();
+		auto& faceToCellPtr = extraction.faceToCellPtr;
+
+		//New position of each new face
+		std::vector<int> newIndex(nNew);
+		size_t nBoundary = 0;
+		for (size_t k = 0; k != nNew; ++k)
+		{
+			nBoundary += (faceToCellPtr[nExisting + k + 1] - faceToCellPtr[nExisting + k] == 1);
+		}
+		int boundary = 0;
+		int interior = static_cast<int>(nBoundary);
+		for (size_t k = 0; k != nNew; ++k)
+		{
+			newIndex[k] = (faceToCellPtr[nExisting + k + 1] - faceToCellPtr[nExisting + k] == 1) ? boundary++ : interior++;
+		}
+
+		//Cell to face
+		auto& cellToFace = extraction.cellToFace;
+		utils::parallel_for(0, static_cast<std::ptrdiff_t>(cellToFace.size()), [&](std::ptrdiff_t e)
+		{
+			if (cellToFace[e] >= static_cast<int>(nExisting))
+			{
+				cellToFace[e] = static_cast<int>(nExisting) + newIndex[cellToFace[e] - nExisting];
+			}
+		});
+
+		//Face to cell rows and first occurrences
+		std::vector<offset_type> ptr(faceToCellPtr.size(), 0);
+		std::vector<int> newFaceCell(nNew), newFaceLocal(nNew);
+		std::copy(faceToCellPtr.begin(), faceToCellPtr.begin() + nExisting + 1, ptr.begin());
+		for (size_t k = 0; k != nNew; ++k)
+		{
+			ptr[nExisting + newIndex[k] + 1] = faceToCellPtr[nExisting + k + 1] - faceToCellPtr[nExisting + k];
+			newFaceCell[newIndex[k]] = extraction.newFaceCell[k];
+			newFaceLocal[newIndex[k]] = extraction.newFaceLocal[k];
+		}
+		for (size_t f = nExisting; f != nExisting + nNew; ++f)
+		{
+			ptr[f + 1] += ptr[f];
+		}
+		auto& faceToCell = extraction.faceToCell;
+		std::vector<int> cells(faceToCell.size());
+		utils::parallel_for(0, static_cast<std::ptrdiff_t>(nExisting + nNew), [&](std::ptrdiff_t f)
+		{
+			auto target = (f < static_cast<std::ptrdiff_t>(nExisting)) ? f : static_cast<std::ptrdiff_t>(nExisting) + newIndex[f - nExisting];
+			std::copy(faceToCell.begin() + faceToCellPtr[f], faceToCell.begin() + faceToCellPtr[f + 1], cells.begin() + ptr[target]);
+		});
+
+		//New boundary faces keep their relative order, so boundary faces stay sorted
+		for (auto& face : extraction.boundaryFaces)
+		{
+			if (face >= static_cast<int>(nExisting))
+			{
+				face = static_cast<int>(nExisting) + newIndex[face - nExisting];
+			}
+		}
+		std::fill(extraction.isBoundary.begin() + nExisting, extraction.isBoundary.end(), false);
+		std::fill(extraction.isBoundary.begin() + nExisting, extraction.isBoundary.begin() + nExisting + nBoundary, true);
+
+		faceToCellPtr.swap(ptr);
+		faceToCell.swap(cells);
+		extraction.newFaceCell.swap(newFaceCell);
+		extraction.newFaceLocal.swap(newFaceLocal);
+		return nBoundary;
+	}
+
+}
@@ -0,0 +1,66 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <vector>
+#include "Collection/CellConnectivity.hpp"
+#include "Adjacency/CSRMatrix.hpp"
+
+namespace PAMELA
+{
+
+	/**
+	 * \brief Unique faces of a set of cells with the cell to face and face to cell incidence.
+	 * Faces matching a row of the existing face connectivity keep that row index, new faces follow in order of first appearance
+	 * when cells are visited in order and their faces in local face order.
+	 */
+	struct FaceExtraction
+	{
+		size_t nExistingFace = 0;
+
+		//Cell and local face of the first occurrence of each new face
+		std::vector<int> newFaceCell;
+		std::vector<int> newFaceLocal;
+
+		//Cell to face, row i holds the faces of cell i in local face order
+		std::vector<CSRMatrix::offset_type> cellToFacePtr;
+		std::vector<int> cellToFace;
+
+		//Face to cell, cells are sorted in each row
+		std::vector<CSRMatrix::offset_type> faceToCellPtr;
+		std::vector<int> faceToCell;
+
+		//Faces with a single cell, as flags and as sorted face indices
+		std::vector<bool> isBoundary;
+		std::vector<int> boundaryFaces;
+
+		size_t size_new() const { return newFaceCell.size(); }
+		size_t size() const { return nExistingFace + newFaceCell.size(); }
+	};
+
+	/**
+	 * \brief Extract the faces of the cells without creating face elements.
+	 * One (face key, ordinal) tuple is emitted per local face from the face tables, tuples are sorted in parallel
+	 * and equal keys are paired up to number the faces and fill both incidences.
+	 * Both connectivities must index the same point numbering.
+	 */
+	void ExtractFaces(const CellConnectivity& cells, const CellConnectivity& existingFaces, FaceExtraction& extraction);
+
+	/**
+	 * \brief Renumber the new faces so that boundary faces, which have a single cell, come before interior faces.
+	 * Both groups keep their order of first appearance, boundary flags and faces follow. Returns the number of new boundary faces.
+	 */
+	size_t MoveBoundaryFacesFirst(FaceExtraction& extraction);
+
+}
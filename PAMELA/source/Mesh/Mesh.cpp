@@ -15,6 +15,10 @@
 #include "Mesh/Mesh.hpp"
 #include "Elements/ElementFactory.hpp"
 #include "Adjacency/Adjacency.hpp"
+#include "Elements/FaceTable.hpp"
+#include "Mesh/FaceExtraction.hpp"
+#include "Elements/EdgeTable.hpp"
+#include "Mesh/EdgeExtraction.hpp"
 #include "Parallel//Communicator.hpp"
 #include <functional>
 #ifdef WITH_MPI
@@ -33,82 +37,281 @@ namespace PAMELA
 
   }
 
-  Mesh::Mesh() : m_PointCollection(PointCollection(ELEMENTS::FAMILY::POINT)),
-  m_LineCollection(LineCollection(ELEMENTS::FAMILY::LINE)),
-  m_PolygonCollection(PolygonCollection(ELEMENTS::FAMILY::POLYGON)),
-  m_PolyhedronCollection(PolyhedronCollection(ELEMENTS::FAMILY::POLYHEDRON)),
-  m_ImplicitPointCollection(PointCollection(ELEMENTS::FAMILY::POINT)), m_ImplicitLineCollection(LineCollection(ELEMENTS::FAMILY::LINE)),
+  Mesh::Mesh() : m_PointCollection(ELEMENTS::FAMILY::POINT),
+  m_LineCollection(ELEMENTS::FAMILY::LINE),
+  m_PolygonCollection(ELEMENTS::FAMILY::POLYGON),
+  m_PolyhedronCollection(ELEMENTS::FAMILY::POLYHEDRON),
+  m_ImplicitPointCollection(ELEMENTS::FAMILY::POINT), m_ImplicitLineCollection(ELEMENTS::FAMILY::LINE),
   m_PolyhedronProperty_double(new Property<PolyhedronCollection, double>(&m_PolyhedronCollection)),
   m_PolyhedronProperty_int(new Property<PolyhedronCollection, int>(&m_PolyhedronCollection)),
   m_AdjacencySet(new AdjacencySet(this))
   {
   }
 
-  void Mesh::CreateFacesFromCells()
+  void Mesh::CreateFacesFromCells(bool implicitInteriorFaces)
   {
 
     LOGINFO("*** Creating Polygons from Polyhedra...");
 
-    //Create adjacency while creating the faces
+    //Faces left implicit by a previous call are reused as existing faces
+    MaterializeImplicitPolygons();
+
     ElementCollection<Polyhedron*>* source = &m_PolyhedronCollection;
     ElementCollection<Polygon*>* target = &m_PolygonCollection;
     ElementCollection<Polyhedron*>* base = &m_PolyhedronCollection;
     auto InitPolyhedronCollectionSize = target->size_all();
-    Adjacency* adj = new Adjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON,source, target, base);
-
-    int nbFace = 0;
-    int FaceIndex = 0;
-    int PolyhedronIndex = 0;
-    int nval = 0;
-    int nrow = 0;
-
-    adj->m_adjacencySparseMatrix->rowPtr.push_back(0);
-    for (auto it = source->begin(); it!= source->end();++it)
+    ASSERT(m_PolyhedronConnectivity.size() == source->size_all(), "Polyhedron connectivity is out of sync with the polyhedron collection");
+    ASSERT(m_PolygonConnectivity.size() == target->size_all(), "Polygon connectivity is out of sync with the polygon collection");
+
+    //Unique faces and both incidences from the sorted face keys, existing polygons are reused
+    FaceExtraction extraction;
+    ExtractFaces(m_PolyhedronConnectivity, m_PolygonConnectivity, extraction);
+
+    //Only the new faces that are materialized are allocated, in order of first appearance
+    const size_t nbNewFace = extraction.size_new();
+    const size_t nbNewPolygon = implicitInteriorFaces ? MoveBoundaryFacesFirst(extraction) : nbNewFace;
+    target->reserve_unique(target->size_all() + nbNewPolygon);
+    m_PolygonConnectivity.reserve(m_PolygonConnectivity.size() + nbNewFace, m_PolygonConnectivity.get_vertices().size() + 4 * nbNewFace);
+    std::vector<Point*> vertexList;
+    CellConnectivity::index_type faceVertices[ELEMENTS::FaceTable::maxVertex];
+    for (size_t i = 0; i != nbNewFace; ++i)
     {
-      Polyhedron* polyhedron = *it;
-      PolyhedronIndex = polyhedron->get_localIndex();
-      auto faces = polyhedron->CreateFaces();
-      nbFace = static_cast<int>(faces.size());
-      for (int j = 0; j < nbFace; j++)
+      auto cell = extraction.newFaceCell[i];
+      const auto table = ELEMENTS::faceTableOf(m_PolyhedronConnectivity.get_vtkType(cell));
+      auto localFace = extraction.newFaceLocal[i];
+      for (int j = 0; j != table.nVertex[localFace]; ++j)
       {
-        auto returned_polygon = target->push_back_unique(faces[j]);
-        FaceIndex = returned_polygon.first->get_localIndex();
-        adj->m_adjacencySparseMatrix->columnIndex.push_back(FaceIndex);
-        adj->m_adjacencySparseMatrix->values.push_back(PolyhedronIndex);
-        nval++;
+        faceVertices[j] = m_PolyhedronConnectivity.begin(cell)[table.vertex[localFace][j]];
       }
-      nrow++;
-      adj->m_adjacencySparseMatrix->rowPtr[nrow] = nval;
+      m_PolygonConnectivity.push_back(table.faceType[localFace], faceVertices, static_cast<size_t>(table.nVertex[localFace]));
+      if (i < nbNewPolygon)
+      {
+        vertexList.resize(table.nVertex[localFace]);
+        for (int j = 0; j != table.nVertex[localFace]; ++j)
+        {
+          vertexList[j] = (*source)[cell]->get_vertexList()[table.vertex[localFace][j]];
+        }
+        auto polygon = ElementFactory::makePolygon(table.faceType[localFace], -1, vertexList, &m_ElementArena);
+        auto index = static_cast<int>(target->size_all());
+        polygon->set_localIndex(index);
+        polygon->set_globalIndex(index);
+        target->push_back_member(polygon, false);
+      }
+    }
+    if (nbNewFace != 0)
+    {
+      m_PolygonBlocksUpToDate = false;
+      m_PolygonGeometryUpToDate = false;
+    }
+
+    //Cell to face, values are the polyhedron indices
+    auto nbCell = static_cast<int>(source->size_all());
+    auto nbFace = static_cast<int>(m_PolygonConnectivity.size());
+    auto cellToFace = new CSRMatrix(nbCell, nbFace, static_cast<int>(extraction.cellToFace.size()));
+    cellToFace->rowPtr.assign(extraction.cellToFacePtr.begin(), extraction.cellToFacePtr.end());
+    cellToFace->columnIndex.swap(extraction.cellToFace);
+    for (int i = 0; i != nbCell; ++i)
+    {
+      std::fill(cellToFace->values.begin() + cellToFace->rowPtr[i], cellToFace->values.begin() + cellToFace->rowPtr[i + 1], i);
     }
-    adj->m_adjacencySparseMatrix->nnz = nval;
-    adj->m_adjacencySparseMatrix->dimColumn = static_cast<int>(target->size_all());
-    adj->m_adjacencySparseMatrix->sortRowIndexAndMoveValues();
-    adj->m_adjacencySparseMatrix->checkMatrix();
+    cellToFace->sortRowIndexAndMoveValues();
+    cellToFace->checkMatrix();
+    Adjacency* adj = new Adjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON, source, target, base, cellToFace);
+
+    //Face to cell, the transpose of the former
+    auto faceToCell = new CSRMatrix(nbFace, nbCell, static_cast<int>(extraction.faceToCell.size()));
+    faceToCell->rowPtr.assign(extraction.faceToCellPtr.begin(), extraction.faceToCellPtr.end());
+    faceToCell->columnIndex.swap(extraction.faceToCell);
+    faceToCell->values = faceToCell->columnIndex;
+    faceToCell->checkMatrix();
+    m_AdjacencySet->TopologicalAdjacencyMap[std::make_tuple(target->get_family(), source->get_family(), base->get_family())] = new Adjacency(ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYHEDRON, target, source, base, faceToCell);
 
     //Add to map
     m_AdjacencySet->TopologicalAdjacencyMap[std::make_tuple(source->get_family(), target->get_family(), base->get_family())] = adj;
 
+    //Boundary faces, counted by the extraction, are all materialized
+    m_PolygonBoundary.swap(extraction.isBoundary);
+    target->addAndCreateGroup("BOUNDARY");
+    auto boundary = target->get_Group("BOUNDARY");
+    boundary->clear();
+    boundary->reserve(extraction.boundaryFaces.size());
+    for (auto face : extraction.boundaryFaces)
+    {
+      ASSERT(static_cast<size_t>(face) < target->size_all(), "Boundary faces must be materialized");
+      boundary->add(face);
+    }
+
     //
     LOGINFO(std::to_string(target->size_all() - InitPolyhedronCollectionSize) + " polygons have been created");
+    if (get_nbImplicitPolygons() != 0)
+    {
+      LOGINFO(std::to_string(get_nbImplicitPolygons()) + " interior faces are implicit");
+    }
     LOGINFO("*** Done");
   }
 
+  void Mesh::MaterializeImplicitPolygons()
+  {
+    if (get_nbImplicitPolygons() == 0)
+    {
+      return;
+    }
+
+    //Before partitioning, store indices of the points are their local indices
+    std::vector<Point*> vertexList;
+    m_PolygonCollection.reserve_unique(m_PolygonConnectivity.size());
+    for (auto face = m_PolygonCollection.size_all(); face != m_PolygonConnectivity.size(); ++face)
+    {
+      vertexList.clear();
+      for (auto vertex = m_PolygonConnectivity.begin(face); vertex != m_PolygonConnectivity.end(face); ++vertex)
+      {
+        ASSERT(*vertex != CellConnectivity::invalid_index, "Implicit faces must be materialized before partitioning");
+        vertexList.push_back(m_PointCollection[*vertex]);
+      }
+      auto polygon = ElementFactory::makePolygon(m_PolygonConnectivity.get_vtkType(face), -1, vertexList, &m_ElementArena);
+      polygon->set_localIndex(static_cast<int>(face));
+      polygon->set_globalIndex(static_cast<int>(face));
+      m_PolygonCollection.push_back_member(polygon, false);
+    }
+  }
+
+
+  void Mesh::CreateEdgesFromCells()
+  {
+
+    LOGINFO("*** Creating Lines from Polyhedra...");
+
+    ElementCollection<Polyhedron*>* source = &m_PolyhedronCollection;
+    ElementCollection<Line*>* target = &m_LineCollection;
+    auto InitLineCollectionSize = target->size_all();
+    ASSERT(m_PolyhedronConnectivity.size() == source->size_all(), "Polyhedron connectivity is out of sync with the polyhedron collection");
+
+    //Existing lines are reused when they join two stored points
+    std::vector<std::uint64_t> existingEdges(target->size_all(), invalidEdgeKey);
+    for (size_t i = 0; i != target->size_all(); ++i)
+    {
+      auto& vertexList = (*target)[i]->get_vertexList();
+      if ((vertexList.size() == 2) && (vertexList[0]->get_storeIndex() >= 0) && (vertexList[1]->get_storeIndex() >= 0))
+      {
+        existingEdges[i] = edgeKey(static_cast<std::uint32_t>(vertexList[0]->get_storeIndex()), static_cast<std::uint32_t>(vertexList[1]->get_storeIndex()));
+      }
+    }
+
+    //Unique edges and cell to edge incidence from the sorted edge keys
+    EdgeExtraction extraction;
+    ExtractEdges(m_PolyhedronConnectivity, existingEdges, extraction);
+
+    //New lines, in order of first appearance
+    target->reserve_unique(extraction.size());
+    for (size_t i = 0; i != extraction.size_new(); ++i)
+    {
+      auto cell = (*source)[extraction.newEdgeCell[i]];
+      const auto table = ELEMENTS::edgeTableOf(cell->get_vtkType());
+      auto localEdge = extraction.newEdgeLocal[i];
+      auto& cellVertices = cell->get_vertexList();
+      auto line = ElementFactory::makeLine(ELEMENTS::TYPE::VTK_LINE, -1, { cellVertices[table.vertex[localEdge][0]], cellVertices[table.vertex[localEdge][1]] }, &m_ElementArena);
+      auto index = static_cast<int>(target->size_all());
+      line->set_localIndex(index);
+      line->set_globalIndex(index);
+      target->push_back_member(line, false);
+    }
+
+    //Cell to edge, values are the polyhedron indices
+    auto nbCell = static_cast<int>(source->size_all());
+    auto nbEdge = static_cast<int>(target->size_all());
+    auto cellToEdge = new CSRMatrix(nbCell, nbEdge, static_cast<int>(extraction.cellToEdge.size()));
+    cellToEdge->rowPtr.assign(extraction.cellToEdgePtr.begin(), extraction.cellToEdgePtr.end());
+    cellToEdge->columnIndex.swap(extraction.cellToEdge);
+    for (int i = 0; i != nbCell; ++i)
+    {
+      std::fill(cellToEdge->values.begin() + cellToEdge->rowPtr[i], cellToEdge->values.begin() + cellToEdge->rowPtr[i + 1], i);
+    }
+    cellToEdge->sortRowIndexAndMoveValues();
+    cellToEdge->checkMatrix();
+
+    //Edge to point, columns are the point indices of the connectivity, values are the line indices
+    auto edgeToPoint = new CSRMatrix(nbEdge, static_cast<int>(m_PointStore.size()), 2 * nbEdge);
+    int nval = 0;
+    for (int i = 0; i != nbEdge; ++i)
+    {
+      for (auto vertex : (*target)[i]->get_vertexList())
+      {
+        if (vertex->get_storeIndex() >= 0)
+        {
+          edgeToPoint->columnIndex[nval] = vertex->get_storeIndex();
+          edgeToPoint->values[nval] = i;
+          ++nval;
+        }
+      }
+      edgeToPoint->rowPtr[i + 1] = nval;
+    }
+    edgeToPoint->nnz = nval;
+    edgeToPoint->columnIndex.resize(nval);
+    edgeToPoint->values.resize(nval);
+    edgeToPoint->sortRowIndexAndMoveValues();
+    edgeToPoint->checkMatrix();
+
+    //Add to map, replacing the adjacencies of a previous call
+    auto& polyhedronToLine = m_AdjacencySet->TopologicalAdjacencyMap[std::make_tuple(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::LINE, ELEMENTS::FAMILY::POLYHEDRON)];
+    delete polyhedronToLine;
+    polyhedronToLine = new Adjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::LINE, ELEMENTS::FAMILY::POLYHEDRON, source, target, source, cellToEdge);
+    auto& lineToPoint = m_AdjacencySet->TopologicalAdjacencyMap[std::make_tuple(ELEMENTS::FAMILY::LINE, ELEMENTS::FAMILY::POINT, ELEMENTS::FAMILY::LINE)];
+    delete lineToPoint;
+    lineToPoint = new Adjacency(ELEMENTS::FAMILY::LINE, ELEMENTS::FAMILY::POINT, ELEMENTS::FAMILY::LINE, target, &m_PointCollection, target, edgeToPoint);
+
+    //
+    LOGINFO(std::to_string(target->size_all() - InitLineCollectionSize) + " lines have been created");
+    LOGINFO("*** Done");
+  }
+
+  PointHandle Mesh::FindMergedPoint(double x, double y, double z)
+  {
+    if (!m_PointMergerUpToDate)
+    {
+      m_PointMerger.rebuild(m_PointStore);
+      m_PointMergerUpToDate = true;
+    }
+    return m_PointMerger.find(m_PointStore, x, y, z);
+  }
 
   std::pair< Point*, bool > Mesh::addPoint(ELEMENTS::TYPE elementType, int index, std::string groupLabel, double x, double y, double z)
   {
-    Point* element = ElementFactory::makePoint(elementType, index, x, y, z);
-    auto returnedElement = m_PointCollection.AddElement(groupLabel, element);
-    if (!returnedElement.second)
+    //Merge with an existing point within tolerance
+    auto existing = FindMergedPoint(x, y, z);
+    if (existing != -1)
     {
-      //LOGWARNING("Try to add an existing element");
+      ASSERT(m_PointCollection[existing]->get_storeIndex() == existing, "Point store is out of sync with the point collection");
+      return m_PointCollection.AddElement(groupLabel, m_PointCollection[existing]);
     }
+
+    //New point, created directly as a view on the store
+    auto storeIndex = m_PointStore.push_back(x, y, z);
+    Point* element = ElementFactory::makePoint(elementType, index, &m_PointStore, storeIndex, &m_ElementArena);
+    auto returnedElement = m_PointCollection.AddElement(groupLabel, element);
+    ASSERT(returnedElement.second && (storeIndex == element->get_localIndex()), "Point store is out of sync with the point collection");
+    m_PointMerger.insert(m_PointStore, storeIndex);
     return returnedElement;
   }
 
   std::pair<Point*, bool > Mesh::addPoint(std::string groupLabel, Point* point)
   {
+    //Merge with an existing point within tolerance
+    auto coord = point->get_coordinates();
+    auto existing = FindMergedPoint(coord.x, coord.y, coord.z);
+    if (existing != -1)
+    {
+      ASSERT(m_PointCollection[existing]->get_storeIndex() == existing, "Point store is out of sync with the point collection");
+      return m_PointCollection.AddElement(groupLabel, m_PointCollection[existing]);
+    }
+
     auto returnedElement = m_PointCollection.AddElement(groupLabel, point);
     if (returnedElement.second)
+    {
+      point->AttachToStore(&m_PointStore);
+      ASSERT(point->get_storeIndex() == point->get_localIndex(), "Point store is out of sync with the point collection");
+      m_PointMerger.insert(m_PointStore, point->get_storeIndex());
+    }
+    else
     {
       //LOGWARNING("Try to add an existing element");
     }
@@ -117,7 +320,7 @@ namespace PAMELA
 
   std::pair< Line*, bool> Mesh::addLine(ELEMENTS::TYPE elementType, int elementIndex, std::string groupLabel, const std::vector<Point*>& vertexList)
   {
-    Line* element = ElementFactory::makeLine(elementType, elementIndex, vertexList);
+    Line* element = ElementFactory::makeLine(elementType, elementIndex, vertexList, &m_ElementArena);
     auto returnedElement = m_LineCollection.AddElement(groupLabel, element);
     if (!returnedElement.second)
     {
@@ -128,9 +331,18 @@ namespace PAMELA
 
   std::pair< Polygon*, bool > Mesh::addPolygon(ELEMENTS::TYPE elementType, int elementIndex, std::string groupLabel, const std::vector<Point*>& vertexList)
   {
-    Polygon* element = ElementFactory::makePolygon(elementType, elementIndex, vertexList);
+    //Rows of implicit faces come right after the polygon objects, they are materialized first to keep both in sync
+    MaterializeImplicitPolygons();
+
+    Polygon* element = ElementFactory::makePolygon(elementType, elementIndex, vertexList, &m_ElementArena);
     auto returnedElement = m_PolygonCollection.AddElement(groupLabel, element);
-    if ( !returnedElement.second )
+    if ( returnedElement.second )
+    {
+      m_PolygonConnectivity.push_back(elementType, vertexList);
+      m_PolygonBlocksUpToDate = false;
+      m_PolygonGeometryUpToDate = false;
+    }
+    else
     {
       //LOGWARNING("Try to add an existing element");
     }
@@ -139,9 +351,15 @@ namespace PAMELA
 
   std::pair< Polyhedron*, bool> Mesh::addPolyhedron(ELEMENTS::TYPE elementType, int elementIndex, std::string groupLabel, const std::vector<Point*>& vertexList)
   {
-    Polyhedron* element = ElementFactory::makePolyhedron(elementType, elementIndex, vertexList);
+    Polyhedron* element = ElementFactory::makePolyhedron(elementType, elementIndex, vertexList, &m_ElementArena);
     auto returnedElement = m_PolyhedronCollection.AddElement(groupLabel, element);
-    if ( !returnedElement.second)
+    if ( returnedElement.second )
+    {
+      m_PolyhedronConnectivity.push_back(elementType, vertexList);
+      m_PolyhedronBlocksUpToDate = false;
+      m_PolyhedronGeometryUpToDate = false;
+    }
+    else
     {
       //LOGWARNING("Try to add an existing polyhedron");
     }
@@ -157,7 +375,7 @@ namespace PAMELA
     for (size_t i=1;i!= pointList.size();++i)
     {
       m_ImplicitPointCollection.AddElement(groupLabel, pointList[i]);
-      Line* element = ElementFactory::makeLine(ELEMENTS::TYPE::VTK_LINE, -1, { pointList[i-1],pointList[i] });
+      Line* element = ElementFactory::makeLine(ELEMENTS::TYPE::VTK_LINE, -1, { pointList[i-1],pointList[i] }, &m_ElementArena);
       m_ImplicitLineCollection.AddElement(groupLabel, element);
     }
   }
@@ -175,22 +393,19 @@ namespace PAMELA
 
     LOGINFO("*** Perform partitioning...");
 
+    //Partitioning works on polygon elements
+    MaterializeImplicitPolygons();
+
     //This is a cell partitioning
     ELEMENTS::FAMILY nodeElement = ELEMENTS::FAMILY::POLYHEDRON;
 
     //Elements affiliation - GLOBAL
     std::vector<int> PolyhedronAffiliation(m_PolyhedronCollection.size_all());
 
-    //PARTITION WISE
-    std::set<int> PolyhedronOwned;
-    std::set<int> PolygonOwned;
-    std::set<int> LineOwned;
-    std::set<int> PointOwned;
-
-    std::set<int> PolyhedronGhost;
-    std::set<int> PolygonGhost;
-    std::set<int> LineGhost;
-    std::set<int> PointGhost;
+    //PARTITION WISE, owned and ghost flags indexed by global index
+    PartitionFilter PolyhedronFilter(m_PolyhedronCollection.size_all());
+    PartitionFilter PolygonFilter(m_PolygonCollection.size_all());
+    PartitionFilter PointFilter(m_PointCollection.size_all());
     utils::pamela_unused( edgeElement);
 
     //Get adjacencies
@@ -201,8 +416,8 @@ namespace PAMELA
     {
       //Compute Partionioning vector from METIS
       LOGINFO("METIS partioning...");
-      auto adjacencyForPartitioning = getAdjacencySet()->get_TopologicalAdjacency(nodeElement, nodeElement, edgeElement);
-      PolyhedronAffiliation = METISPartitioning(adjacencyForPartitioning, CommRankSize);
+      auto edgeToNode = getAdjacencySet()->get_TopologicalAdjacency(edgeElement, nodeElement, nodeElement);
+      PolyhedronAffiliation = METISPartitioning(edgeToNode, CommRankSize);
     }
     else
     {
@@ -216,13 +431,13 @@ namespace PAMELA
 
     //POLYHEDRON
     //--OWNED POLYHEDRA
-    int ind = 0;
+    std::vector<int> PolyhedronOwned;
     for (size_t i = 0; i != PolyhedronAffiliation.size(); ++i)
     {
       if (PolyhedronAffiliation[i] == ipartition)
       {
-        PolyhedronOwned.insert(static_cast<int>(i));
-        ind++;
+        PolyhedronFilter.set_owned(static_cast<int>(i));
+        PolyhedronOwned.push_back(static_cast<int>(i));
       }
     }
 
@@ -234,7 +449,7 @@ namespace PAMELA
       {
         if (PolyhedronAffiliation[*it2] != ipartition)
         {
-          PolyhedronGhost.insert(*it2);
+          PolyhedronFilter.set_ghost(*it2);
           m_neighborList.insert(PolyhedronAffiliation[*it2]);
         }
       }
@@ -256,7 +471,7 @@ namespace PAMELA
         if ((std::equal(PolyToPart.begin() + 1, PolyToPart.end(), PolyToPart.begin())) || PolyToPart.size() == 1)
         {
           //All points connect to polyhedra of the current partition
-          PolygonOwned.insert(adj_Polyhedron2Polygon.first[i]);
+          PolygonFilter.set_owned(adj_Polyhedron2Polygon.first[i]);
         }
         else
         {
@@ -265,11 +480,11 @@ namespace PAMELA
 
           if (ival == ipartition)
           {
-            PolygonOwned.insert(adj_Polyhedron2Polygon.first[i]);
+            PolygonFilter.set_owned(adj_Polyhedron2Polygon.first[i]);
           }
           else
           {
-            PolygonGhost.insert(adj_Polyhedron2Polygon.first[i]);
+            PolygonFilter.set_ghost(adj_Polyhedron2Polygon.first[i]);
           }
 
         }
@@ -290,7 +505,7 @@ namespace PAMELA
         if ((std::equal(PolyToPart.begin() + 1, PolyToPart.end(), PolyToPart.begin())) || PolyToPart.size() == 1)
         {
           //All points connect to polyhedra of the current partition
-          PointOwned.insert(adj_Poly2Point.first[i]);
+          PointFilter.set_owned(adj_Poly2Point.first[i]);
         }
         else
         {
@@ -300,11 +515,11 @@ namespace PAMELA
           if (ival == ipartition)
           {
             //The majority of points connect to polyhedra that belongs to the current partition
-            PointOwned.insert(adj_Poly2Point.first[i]);
+            PointFilter.set_owned(adj_Poly2Point.first[i]);
           }
           else
           {
-            PointGhost.insert(adj_Poly2Point.first[i]);
+            PointFilter.set_ghost(adj_Poly2Point.first[i]);
           }
 
         }
@@ -314,54 +529,60 @@ namespace PAMELA
 
     //ClearAfterPartitioning
     LOGINFO("Clean mesh...");
-    m_PolyhedronCollection.ClearAfterPartitioning(PolyhedronOwned, PolyhedronGhost);
-    m_PolygonCollection.ClearAfterPartitioning(PolygonOwned, PolygonGhost);
-    m_PointCollection.ClearAfterPartitioning(PointOwned, PointGhost);
-    m_PolyhedronProperty_double->ClearAfterPartitioning(PolyhedronOwned, PolyhedronGhost);
-    m_PolyhedronProperty_int->ClearAfterPartitioning(PolyhedronOwned, PolyhedronGhost);
+    std::vector<Polyhedron*> AllPolyhedra(m_PolyhedronCollection.begin(), m_PolyhedronCollection.end());
+    std::vector<Polygon*> AllPolygons(m_PolygonCollection.begin(), m_PolygonCollection.end());
+    std::vector<Point*> AllPoints(m_PointCollection.begin(), m_PointCollection.end());
+    m_PolyhedronCollection.ClearAfterPartitioning(PolyhedronFilter);
+    m_PolygonCollection.ClearAfterPartitioning(PolygonFilter);
+    m_PointCollection.ClearAfterPartitioning(PointFilter);
+    ReleaseNonLocalElements(AllPolyhedra, AllPolygons, AllPoints);
+    CompactConnectivity();
+    m_PolyhedronBlocksUpToDate = false;
+    m_PolygonBlocksUpToDate = false;
+    InvalidateGeometry();
+    CompactPointStore();
+    m_PolyhedronProperty_double->ClearAfterPartitioning(PolyhedronFilter);
+    m_PolyhedronProperty_int->ClearAfterPartitioning(PolyhedronFilter);
     LOGINFO("*** Done...");
     LOGINFO("Clean Adjacency...");
-    m_AdjacencySet->ClearAfterPartitioning(PolyhedronOwned, PolyhedronGhost,PolygonOwned, PolygonGhost);
+    m_AdjacencySet->ClearAfterPartitioning(PolyhedronFilter, PolygonFilter);
     LOGINFO("*** Done...");
 
     //}
   }
 
 
-  std::vector<int> Mesh::METISPartitioning(Adjacency* adjacency, unsigned int npartition)
+  std::vector<int> Mesh::METISPartitioning(Adjacency* edgeToNode, unsigned int npartition)
   {
 
 #ifdef WITH_METIS
 
-    ASSERT(adjacency->get_sourceElementCollection() == adjacency->get_targetElementCollection(), "Partitioning can only be done with adjacency of same elements");
-    ASSERT(adjacency->get_sourceElementCollection()->size_all() > npartition, "Number of mesh elements must be greater than the number of partitions");
-
-    auto csrMatrix = adjacency->get_adjacencySparseMatrix();
-
+    ASSERT(edgeToNode->get_targetElementCollection()->size_all() > npartition, "Number of mesh elements must be greater than the number of partitions");
 
     // make sure locally we use METIS's types (which are in global namespace) and not grid::<type>
     using idx_t = ::idx_t;
 
+    //The graph is built with the METIS types from the nodes of each edge, its arrays are handed to METIS without copy
+    auto graph = CSRMatrixT<idx_t, idx_t>::dualGraph(edgeToNode->get_adjacencySparseMatrix());
+
     idx_t options[METIS_NOPTIONS];
     METIS_SetDefaultOptions(options);
 
     // Some type casts and constants
-    idx_t nnodes = static_cast<idx_t>(adjacency->get_sourceElementCollection()->size_all());
+    idx_t nnodes = graph->dimRow;
     idx_t nconst = 1;
     idx_t objval = 0;
     std::vector<idx_t> partitionVector(nnodes);
 
     idx_t int_partition = static_cast<idx_t>(npartition);
-    //TODO This is a copy to have idx_t. It can be memory consuming.
-    std::vector<idx_t> rowPtrMetis(csrMatrix->rowPtr.begin(), csrMatrix->rowPtr.end());
-    std::vector<idx_t> columnIndexMetis(csrMatrix->columnIndex.begin(), csrMatrix->columnIndex.end());
-    METIS_PartGraphRecursive(&nnodes, &nconst, rowPtrMetis.data(), columnIndexMetis.data(),
+    METIS_PartGraphRecursive(&nnodes, &nconst, graph->rowPtr.data(), graph->columnIndex.data(),
         nullptr, nullptr, nullptr, &int_partition, nullptr, nullptr, options, &objval, partitionVector.data());
+    delete graph;
 
     return std::vector<int>(partitionVector.begin(), partitionVector.end());
 
 #else
-    utils::pamela_unused(adjacency);
+    utils::pamela_unused(edgeToNode);
     utils::pamela_unused(npartition);
     LOGERROR("METIS partitioner is not available");
     return {};
@@ -377,43 +598,10 @@ namespace PAMELA
       std::vector<int> val(m_PolyhedronCollection.size_all(), 0);
       return val;
     }
-    std::vector< double > max= {std::numeric_limits< double >::min(),
-      std::numeric_limits< double >::min(),
-      std::numeric_limits< double  >::min() };
-
-    std::vector< double > min= {std::numeric_limits< double >::max(),
-      std::numeric_limits< double >::max(),
-      std::numeric_limits< double  >::max() };
-    for( auto point : m_PointCollection )
-    {
-      auto coord = point->get_coordinates();
-      if( coord.x > max[0] )
-      {
-        max[0] = coord.x;
-      }
-      if( coord.y > max[1] )
-      {
-        max[1] = coord.y;
-      }
-      if( coord.z > max[2] )
-      {
-        max[2] = coord.z;
-      }
-      if( coord.x < min[0] )
-      {
-        min[0] = coord.x;
-      }
-      if( coord.y < min[1] )
-      {
-        min[1] = coord.y;
-      }
-      if( coord.z < min[2] )
-      {
-        min[2] = coord.z;
-      }
-    }
-    double xdiff = std::fabs( max[0] - min[0] );
-    double ydiff = std::fabs( max[1] - min[1] );
+    Coordinates min, max;
+    m_PointStore.get_BoundingBox(min, max);
+    double xdiff = std::fabs( max.x - min.x );
+    double ydiff = std::fabs( max.y - min.y );
     double shift = 0.;
     int dim_i = -1;
     if ( xdiff > ydiff )
@@ -429,13 +617,13 @@ namespace PAMELA
       dim_i = 1;
     }
     std::vector< int > partitionVector( m_PolyhedronCollection.size_all(),0 );
-    int count = 0;
-    for( auto cell : m_PolyhedronCollection )
+    double begin = ( dim_i == 0 ) ? min.x : min.y;
+    auto& center = ( dim_i == 0 ) ? get_PolyhedronGeometry().x : get_PolyhedronGeometry().y;
+    for( size_t i = 0; i != partitionVector.size(); ++i )
     {
-      auto center = cell->get_centroidCoordinates();
-      double dist_to_begin = std::fabs(center[dim_i] - min[dim_i]);
+      double dist_to_begin = std::fabs(center[i] - begin);
       int part_nb = dist_to_begin / shift;
-      partitionVector[count++] = part_nb;
+      partitionVector[i] = part_nb;
       if (part_nb >= CommRankSize )
       {
         LOGERROR("Wrong partition number attribute");
@@ -446,17 +634,240 @@ namespace PAMELA
 
   }
 
+  void Mesh::ReleaseNonLocalElements(const std::vector<Polyhedron*>& polyhedra, const std::vector<Polygon*>& polygons, const std::vector<Point*>& points)
+  {
+    //Elements are flagged by their index before partitioning, which is their global index
+    std::vector<char> keepPolyhedron(polyhedra.size(), 0);
+    std::vector<char> keepPolygon(polygons.size(), 0);
+    std::vector<char> keepPoint(points.size(), 0);
+    for (auto polyhedron : m_PolyhedronCollection)
+    {
+      keepPolyhedron[polyhedron->get_globalIndex()] = 1;
+    }
+    for (auto polygon : m_PolygonCollection)
+    {
+      keepPolygon[polygon->get_globalIndex()] = 1;
+    }
+    for (auto point : m_PointCollection)
+    {
+      keepPoint[point->get_globalIndex()] = 1;
+    }
+
+    //Vertices of ghost elements may not be in the point collection, they stay alive with their own coordinates
+    auto keepVertices = [&](const std::vector<Point*>& vertexList)
+    {
+      for (auto vertex : vertexList)
+      {
+        auto i = static_cast<size_t>(vertex->get_globalIndex());
+        if ((i < points.size()) && (points[i] == vertex) && (keepPoint[i] == 0))
+        {
+          keepPoint[i] = 2;
+          vertex->DetachFromStore();
+        }
+      }
+    };
+    for (auto polyhedron : m_PolyhedronCollection)
+    {
+      keepVertices(polyhedron->get_vertexList());
+    }
+    for (auto polygon : m_PolygonCollection)
+    {
+      keepVertices(polygon->get_vertexList());
+    }
+    for (auto line : m_LineCollection)
+    {
+      keepVertices(line->get_vertexList());
+    }
+
+    //Bulk release
+    size_t nbReleased = 0;
+    auto release = [&](ElementBase* element)
+    {
+      if (m_ElementArena.owns(element))
+      {
+        m_ElementArena.destroy(element);
+        ++nbReleased;
+      }
+    };
+    for (size_t i = 0; i != polyhedra.size(); ++i)
+    {
+      if (keepPolyhedron[i] == 0) release(polyhedra[i]);
+    }
+    for (size_t i = 0; i != polygons.size(); ++i)
+    {
+      if (keepPolygon[i] == 0) release(polygons[i]);
+    }
+    for (size_t i = 0; i != points.size(); ++i)
+    {
+      if (keepPoint[i] == 0) release(points[i]);
+    }
+
+    LOGINFO(std::to_string(nbReleased) + " non-local elements have been released");
+  }
+
+  void Mesh::CompactConnectivity()
+  {
+    //Before partitioning, global indices are the rows of the connectivity
+    std::vector<int> oldRows;
+    oldRows.reserve(m_PolyhedronCollection.size_all());
+    for (auto polyhedron : m_PolyhedronCollection)
+    {
+      oldRows.push_back(polyhedron->get_globalIndex());
+    }
+    m_PolyhedronConnectivity.Gather(oldRows);
+
+    oldRows.clear();
+    oldRows.reserve(m_PolygonCollection.size_all());
+    for (auto polygon : m_PolygonCollection)
+    {
+      oldRows.push_back(polygon->get_globalIndex());
+    }
+    m_PolygonConnectivity.Gather(oldRows);
+
+    if (!m_PolygonBoundary.empty())
+    {
+      std::vector<bool> polygonBoundary(oldRows.size());
+      for (size_t i = 0; i != oldRows.size(); ++i)
+      {
+        polygonBoundary[i] = m_PolygonBoundary[oldRows[i]];
+      }
+      m_PolygonBoundary.swap(polygonBoundary);
+    }
+  }
+
+  const std::map<ELEMENTS::TYPE, std::vector<int>>& Mesh::get_PolyhedronBlocks()
+  {
+    if (!m_PolyhedronBlocksUpToDate)
+    {
+      ASSERT(m_PolyhedronConnectivity.size() == m_PolyhedronCollection.size_all(), "Polyhedron connectivity is out of sync with the collection");
+      m_PolyhedronConnectivity.get_TypeBlocks(m_PolyhedronBlocks);
+      m_PolyhedronBlocksUpToDate = true;
+    }
+    return m_PolyhedronBlocks;
+  }
+
+  const std::map<ELEMENTS::TYPE, std::vector<int>>& Mesh::get_PolygonBlocks()
+  {
+    if (!m_PolygonBlocksUpToDate)
+    {
+      ASSERT(m_PolygonConnectivity.size() >= m_PolygonCollection.size_all(), "Polygon connectivity is out of sync with the collection");
+      m_PolygonConnectivity.get_TypeBlocks(m_PolygonBlocks);
+      m_PolygonBlocksUpToDate = true;
+    }
+    return m_PolygonBlocks;
+  }
+
+  void Mesh::ComputePolyhedronGeometry(CellGeometry& geometry)
+  {
+    auto& blocks = get_PolyhedronBlocks();
+    geometry.resize(m_PolyhedronCollection.size_all());
+
+    //Vertices of ghost cells may not be in the store after partitioning
+    auto& x = m_PointStore.get_x();
+    auto& y = m_PointStore.get_y();
+    auto& z = m_PointStore.get_z();
+    GEOMETRY::ComputeVolumesAndCentroids(blocks, [&](int cell, int j, double& xj, double& yj, double& zj)
+    {
+      auto vertex = m_PolyhedronConnectivity.begin(cell)[j];
+      if (vertex != CellConnectivity::invalid_index)
+      {
+        xj = x[vertex]; yj = y[vertex]; zj = z[vertex];
+      }
+      else
+      {
+        auto coordinates = m_PolyhedronCollection[cell]->get_vertexList()[j]->get_coordinates();
+        xj = coordinates.x; yj = coordinates.y; zj = coordinates.z;
+      }
+    }, geometry);
+  }
+
+  const CellGeometry& Mesh::get_PolyhedronGeometry()
+  {
+    if (!m_PolyhedronGeometryUpToDate)
+    {
+      ComputePolyhedronGeometry(m_PolyhedronGeometry);
+      m_PolyhedronGeometryUpToDate = true;
+    }
+    return m_PolyhedronGeometry;
+  }
+
+  void Mesh::ComputePolygonGeometry(FaceGeometry& geometry)
+  {
+    auto& blocks = get_PolygonBlocks();
+    geometry.resize(m_PolygonConnectivity.size());
+
+    //Vertices of ghost faces may not be in the store after partitioning, implicit faces only exist before
+    auto& x = m_PointStore.get_x();
+    auto& y = m_PointStore.get_y();
+    auto& z = m_PointStore.get_z();
+    GEOMETRY::ComputeFaceGeometry(blocks, [&](int face, int j, double& xj, double& yj, double& zj)
+    {
+      auto vertex = m_PolygonConnectivity.begin(face)[j];
+      if (vertex != CellConnectivity::invalid_index)
+      {
+        xj = x[vertex]; yj = y[vertex]; zj = z[vertex];
+      }
+      else
+      {
+        auto coordinates = m_PolygonCollection[face]->get_vertexList()[j]->get_coordinates();
+        xj = coordinates.x; yj = coordinates.y; zj = coordinates.z;
+      }
+    }, geometry);
+  }
+
+  const FaceGeometry& Mesh::get_PolygonGeometry()
+  {
+    if (!m_PolygonGeometryUpToDate)
+    {
+      ComputePolygonGeometry(m_PolygonGeometry);
+      m_PolygonGeometryUpToDate = true;
+    }
+    return m_PolygonGeometry;
+  }
+
+  void Mesh::CompactPointStore()
+  {
+    //Keep the coordinates of local points only, in the order of the collection
+    std::vector<PointHandle> oldIndex;
+    const CellConnectivity::index_type invalid = CellConnectivity::invalid_index;
+    std::vector<CellConnectivity::index_type> oldToNew(m_PointStore.size(), invalid);
+    oldIndex.reserve(m_PointCollection.size_all());
+    for (auto point : m_PointCollection)
+    {
+      //Detached points hold their own coordinates and have nothing to keep in the store
+      const PointHandle storeIndex = point->get_storeIndex();
+      if (storeIndex < 0)
+      {
+        continue;
+      }
+      ASSERT(static_cast<size_t>(storeIndex) < oldToNew.size(), "Point is outside of the point store");
+      oldToNew[static_cast<size_t>(storeIndex)] = static_cast<CellConnectivity::index_type>(oldIndex.size());
+      oldIndex.push_back(storeIndex);
+    }
+    m_PointStore.Gather(oldIndex);
+    m_PolyhedronConnectivity.Renumber(oldToNew);
+    m_PolygonConnectivity.Renumber(oldToNew);
+
+    PointHandle i = 0;
+    for (auto point : m_PointCollection)
+    {
+      if (point->get_storeIndex() >= 0)
+      {
+        point->set_storeIndex(i++);
+      }
+    }
+  }
+
   void Mesh::CreateLineGroupWithAdjacency(std::string Label, Adjacency* adjacency)
   {
 
     auto& line_collection = m_LineCollection;
-    auto& point_collection = m_PointCollection;
 
     //CSR Matrix
     auto csr_matrix = adjacency->get_adjacencySparseMatrix();
     auto dimRow = csr_matrix->dimRow;
-    auto columIndex = csr_matrix->columnIndex;
-    auto rowPtr = csr_matrix->rowPtr;
+    const auto& columIndex = csr_matrix->columnIndex;
+    const auto& rowPtr = csr_matrix->rowPtr;
 
     int nb_lines = 0;
     int nb_points = 0;
@@ -465,32 +876,32 @@ namespace PAMELA
     {
 
       //Compute Node coordinates
+      auto& geometry = get_PolyhedronGeometry();
       int isource = 0, itarget = 0, ipoint = static_cast<int>(m_PointCollection.size_owned()) , iline = static_cast<int>(m_LineCollection.size_owned());
+      std::vector<Line*> edges;
+      edges.reserve(columIndex.size());
 
       for (auto irow = 0; irow != dimRow; ++irow)
       {
         if (rowPtr[irow + 1]- rowPtr[irow]>0)
         {
-          auto it = get_PolyhedronCollection()->begin_owned() + irow;
-          auto xyz1 = (*it)->get_centroidCoordinates();
-          auto source_point = ElementFactory::makePoint(ELEMENTS::TYPE::VTK_VERTEX, ipoint, xyz1[0], xyz1[1], xyz1[2]);
-          auto source_rpoint = point_collection.AddElement(Label, source_point).first;
+          auto source_point = ElementFactory::makePoint(ELEMENTS::TYPE::VTK_VERTEX, ipoint, geometry.x[irow], geometry.y[irow], geometry.z[irow], &m_ElementArena);
+          auto source_rpoint = addPoint(Label, source_point).first;
           ++ipoint; ++nb_points;
           itarget = isource;
           for (auto icol = rowPtr[irow]; icol != rowPtr[irow + 1]; ++icol)
           {
-            if (icol != columIndex[icol])
+            if (irow != columIndex[icol])
             {
               itarget = itarget + 1;
-              auto it2 = get_PolyhedronCollection()->begin_owned() + columIndex[icol];
-              auto xyz2 = (*it2)->get_centroidCoordinates();
-              auto target_point = ElementFactory::makePoint(ELEMENTS::TYPE::VTK_VERTEX, ipoint, xyz2[0], xyz2[1], xyz2[2]);
-              auto target_rpoint = point_collection.AddElement(Label, target_point).first;
+              auto jcol = columIndex[icol];
+              auto target_point = ElementFactory::makePoint(ELEMENTS::TYPE::VTK_VERTEX, ipoint, geometry.x[jcol], geometry.y[jcol], geometry.z[jcol], &m_ElementArena);
+              auto target_rpoint = addPoint(Label, target_point).first;
               ++ipoint;
               auto edgev = { source_rpoint , target_rpoint };
-              auto edge = ElementFactory::makeLine(ELEMENTS::TYPE::VTK_LINE, iline, edgev);
+              auto edge = ElementFactory::makeLine(ELEMENTS::TYPE::VTK_LINE, iline, edgev, &m_ElementArena);
               ++iline;
-              line_collection.AddElement(Label, edge);
+              edges.push_back(edge);
             }
 
           }
@@ -498,6 +909,7 @@ namespace PAMELA
           nb_lines++;
         }
       }
+      line_collection.AddElements(line_collection.get_GroupIndex(Label), edges.begin(), edges.end());
 
     }
     if (nb_lines >0)
@@ -14,11 +14,17 @@
 
 #pragma once
 #include <vector>
+#include <map>
 #include "Elements/Point.hpp"
 #include "Elements/Line.hpp"
 #include "Elements/Polygon.hpp"
 #include "Elements/Polyhedron.hpp"
+#include "Elements/ElementArena.hpp"
+#include "Elements/CellGeometry.hpp"
 #include "Collection/Collection.hpp"
+#include "Collection/PointStore.hpp"
+#include "Collection/PointMerger.hpp"
+#include "Collection/CellConnectivity.hpp"
 #include "Property/Property.hpp"
 #include "Adjacency/AdjacencySet.hpp"
 #include "Utils/Utils.hpp"
@@ -43,6 +49,19 @@ namespace PAMELA
 
       LineCollection*  get_ImplicitLineCollection() { return &m_ImplicitLineCollection; }
 
+      //Coordinates of m_PointCollection, indexed as the collection
+      const PointStore& get_PointStore() const { return m_PointStore; }
+
+      //Cell to vertex connectivity, rows indexed as the collections
+      const CellConnectivity& get_PolyhedronConnectivity() const { return m_PolyhedronConnectivity; }
+      const CellConnectivity& get_PolygonConnectivity() const { return m_PolygonConnectivity; }
+
+      //Number of faces, including implicit interior faces which have no polygon in the collection
+      size_t get_nbPolygons() const { return m_PolygonConnectivity.size(); }
+      size_t get_nbImplicitPolygons() const { return m_PolygonConnectivity.size() - m_PolygonCollection.size_all(); }
+      //Faces with a single polyhedron, indexed as the polygon connectivity, set by CreateFacesFromCells
+      const std::vector<bool>& get_BoundaryPolygons() const { return m_PolygonBoundary; }
+
       Property<PolyhedronCollection, double>* get_PolyhedronProperty_double() const { return m_PolyhedronProperty_double; }
       Property<PolyhedronCollection, int>* get_PolyhedronProperty_int() const { return m_PolyhedronProperty_int; }
 
@@ -52,12 +71,66 @@ namespace PAMELA
         return m_AdjacencySet;
       }
 
+      ///Iteration over homogeneous blocks of polyhedra
+      //Local indices of the polyhedra, per vtk type
+      const std::map<ELEMENTS::TYPE, std::vector<int>>& get_PolyhedronBlocks();
+      //Local indices of the polygons, per vtk type
+      const std::map<ELEMENTS::TYPE, std::vector<int>>& get_PolygonBlocks();
+
+      //Volumes, centroids and bounding boxes of all polyhedra, computed type by type with the batch kernels
+      void ComputePolyhedronGeometry(CellGeometry& geometry);
+      //Areas, unit normals and centroids of all polygons
+      void ComputePolygonGeometry(FaceGeometry& geometry);
+
+      ///Geometry cache
+      //Polyhedron geometry, computed on first use
+      const CellGeometry& get_PolyhedronGeometry();
+      //Polygon geometry, computed on first use
+      const FaceGeometry& get_PolygonGeometry();
+
+      //To be called when elements or point coordinates are modified
+      void InvalidateGeometry() { m_PolyhedronGeometryUpToDate = false; m_PolygonGeometryUpToDate = false; m_PointMergerUpToDate = false; }
+
+      //Call function(cell, localIndex) for each polyhedron of type elementType, cell is given with its concrete type
+      template <ELEMENTS::TYPE elementType, class Function>
+      void forEachCell(Function&& function)
+      {
+        static_assert(ELEMENTS::TypeTraits<elementType>::family() == ELEMENTS::FAMILY::POLYHEDRON, "forEachCell iterates over polyhedra");
+        auto& blocks = get_PolyhedronBlocks();
+        auto block = blocks.find(elementType);
+        if (block == blocks.end())
+        {
+          return;
+        }
+        for (auto i : block->second)
+        {
+          function(static_cast<ElementSpe<ELEMENTS::FAMILY::POLYHEDRON, elementType>*>(m_PolyhedronCollection[i]), i);
+        }
+      }
+
+      //Call function(cell, localIndex) for all polyhedra, the type is dispatched once per block
+      template <class Function>
+      void forEachCell(Function&& function)
+      {
+        forEachCell<ELEMENTS::TYPE::VTK_TETRA>(function);
+        forEachCell<ELEMENTS::TYPE::VTK_HEXAHEDRON>(function);
+        forEachCell<ELEMENTS::TYPE::VTK_WEDGE>(function);
+        forEachCell<ELEMENTS::TYPE::VTK_PYRAMID>(function);
+      }
+
       virtual void Distort(double alpha) {
         utils::pamela_unused(alpha);
       }
 
       ////Updaters
-      void CreateFacesFromCells();
+      //With implicitInteriorFaces, polygons are created for boundary faces only, interior faces exist only in the
+      //polygon connectivity, adjacencies and geometry, after the polygons of the collection.
+      //Boundary faces are flagged and gathered in the BOUNDARY polygon group
+      void CreateFacesFromCells(bool implicitInteriorFaces = false);
+      //Create the polygons of the implicit interior faces
+      void MaterializeImplicitPolygons();
+      //Create the edges of the polyhedra as lines, with the polyhedron to line and line to point adjacencies
+      void CreateEdgesFromCells();
 
       ///Functions to add elements or group to the mesh
       //Add Element
@@ -93,12 +166,39 @@ namespace PAMELA
 
     protected:
 
+      //Storage of the elements created by the mesh
+      ElementArena m_ElementArena;
+
       //Explicit Element Collections - First owned then ghosts
       PointCollection m_PointCollection;
       LineCollection m_LineCollection;
       PolygonCollection m_PolygonCollection;
       PolyhedronCollection m_PolyhedronCollection;
 
+      //Point coordinates - Structure of arrays
+      PointStore m_PointStore;
+
+      //Spatial index of the point store used to merge duplicated points, rebuilt when outdated
+      PointMerger m_PointMerger;
+      bool m_PointMergerUpToDate = false;
+
+      //Connectivity - CSR
+      CellConnectivity m_PolyhedronConnectivity;
+      CellConnectivity m_PolygonConnectivity;
+      std::vector<bool> m_PolygonBoundary;
+
+      //Elements sorted by type, rebuilt when outdated
+      std::map<ELEMENTS::TYPE, std::vector<int>> m_PolyhedronBlocks;
+      bool m_PolyhedronBlocksUpToDate = false;
+      std::map<ELEMENTS::TYPE, std::vector<int>> m_PolygonBlocks;
+      bool m_PolygonBlocksUpToDate = false;
+
+      //Cached geometry
+      CellGeometry m_PolyhedronGeometry;
+      bool m_PolyhedronGeometryUpToDate = false;
+      FaceGeometry m_PolygonGeometry;
+      bool m_PolygonGeometryUpToDate = false;
+
       //Implicit Element Collections
       PointCollection m_ImplicitPointCollection;
       LineCollection m_ImplicitLineCollection;
@@ -112,9 +212,17 @@ namespace PAMELA
 
       std::set<int> m_neighborList;
 
-      std::vector<int> METISPartitioning(Adjacency* adjacency, unsigned int npartition);
+      //Stored point within the merge tolerance of the coordinates, -1 if none
+      PointHandle FindMergedPoint(double x, double y, double z);
+
+      //Graph of the nodes linked by an edge element, built directly from the nodes of each edge
+      std::vector<int> METISPartitioning(Adjacency* edgeToNode, unsigned int npartition);
       std::vector<int> TRIVIALPartitioning( unsigned int npartition );
 
+      void ReleaseNonLocalElements(const std::vector<Polyhedron*>& polyhedra, const std::vector<Polygon*>& polygons, const std::vector<Point*>& points);
+      void CompactConnectivity();
+      void CompactPointStore();
+
     private:
       std::string m_partitioning_type { "METIS" };
 
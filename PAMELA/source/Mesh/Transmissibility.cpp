@@ -0,0 +1,184 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#include "Mesh/Transmissibility.hpp"
+#include "Adjacency/Adjacency.hpp"
+#include "Elements/CellGeometry.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/ParallelFor.hpp"
+#include <cmath>
+
+namespace PAMELA
+{
+
+	namespace TPFA
+	{
+
+		namespace
+		{
+			//Property values, or a constant when the property does not exist
+			struct CellProperty
+			{
+				CellProperty(Mesh* mesh, const std::string& label, const CellProperty* fallback, double value) : data(nullptr), constant(value)
+				{
+					auto& properties = mesh->get_PolyhedronProperty_double()->get_PropertyMap();
+					auto it = properties.find(label);
+					if ((it != properties.end()) && (it->second.size_all() != 0))
+					{
+						data = &it->second;
+					}
+					else if (fallback != nullptr)
+					{
+						data = fallback->data;
+						constant = fallback->constant;
+					}
+				}
+
+				double operator()(int cell) const { return (data != nullptr) ? (*data)[cell] : constant; }
+
+				ParallelEnsemble<double>* data;
+				double constant;
+			};
+
+			//Half transmissibility of a face seen from a cell: A n.K.d / d.d
+			double HalfTransmissibility(const CellGeometry& cells, const FaceGeometry& faces, int cell, int face, double kx, double ky, double kz)
+			{
+				const double dx = faces.x[face] - cells.x[cell];
+				const double dy = faces.y[face] - cells.y[cell];
+				const double dz = faces.z[face] - cells.z[cell];
+				const double d2 = dx * dx + dy * dy + dz * dz;
+				if (d2 == 0)
+				{
+					return 0;
+				}
+				const double flux = faces.nx[face] * kx * dx + faces.ny[face] * ky * dy + faces.nz[face] * kz * dz;
+				return faces.area[face] * std::fabs(flux) / d2;
+			}
+		}
+
+		void ComputeTransmissibility(Mesh* mesh, Transmissibility& transmissibility)
+		{
+			LOGINFO("*** Computing TPFA transmissibilities...");
+
+			auto nbPolygon = mesh->get_nbPolygons();
+			transmissibility = Transmissibility();
+			transmissibility.resize(nbPolygon);
+
+			//Cells of each face, from the polyhedron to polygon adjacency
+			auto adjacency = mesh->getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON);
+			auto csr = adjacency->get_adjacencySparseMatrix();
+			for (int cell = 0; cell != csr->dimRow; ++cell)
+			{
+				for (auto k = csr->rowPtr[cell]; k != csr->rowPtr[cell + 1]; ++k)
+				{
+					auto face = csr->columnIndex[k];
+					if (transmissibility.cell0[face] < 0)
+					{
+						transmissibility.cell0[face] = cell;
+					}
+					else
+					{
+						ASSERT(transmissibility.cell1[face] < 0, "Face shared by more than two cells");
+						transmissibility.cell1[face] = cell;
+					}
+				}
+			}
+
+			//Permeability
+			CellProperty permx(mesh, "PERMX", nullptr, 0);
+			CellProperty permy(mesh, "PERMY", &permx, 0);
+			CellProperty permz(mesh, "PERMZ", &permx, 0);
+			CellProperty ntg(mesh, "NTG", nullptr, 1);
+			if (permx.data == nullptr)
+			{
+				LOGERROR("PERMX is required to compute transmissibilities");
+			}
+
+			auto& cells = mesh->get_PolyhedronGeometry();
+			auto& faces = mesh->get_PolygonGeometry();
+			auto half = [&](int cell, int face)
+			{
+				return HalfTransmissibility(cells, faces, cell, face, permx(cell) * ntg(cell), permy(cell) * ntg(cell), permz(cell));
+			};
+
+			utils::parallel_for(0, static_cast<std::ptrdiff_t>(nbPolygon), [&](std::ptrdiff_t i)
+			{
+				auto face = static_cast<int>(i);
+				auto cell0 = transmissibility.cell0[face];
+				auto cell1 = transmissibility.cell1[face];
+				if (cell0 >= 0)
+				{
+					transmissibility.halfTransmissibility0[face] = half(cell0, face);
+				}
+				if (cell1 >= 0)
+				{
+					transmissibility.halfTransmissibility1[face] = half(cell1, face);
+					const double t0 = transmissibility.halfTransmissibility0[face];
+					const double t1 = transmissibility.halfTransmissibility1[face];
+					transmissibility.transmissibility[face] = (t0 + t1 > 0) ? t0 * t1 / (t0 + t1) : 0.;
+				}
+			});
+
+			LOGINFO("*** Done");
+		}
+
+		Adjacency* CreateAdjacency(Mesh* mesh, const std::string& label, const Transmissibility& transmissibility)
+		{
+			auto polyhedra = mesh->get_PolyhedronCollection();
+			auto nbPolyhedron = static_cast<int>(polyhedra->size_all());
+			auto adjacency = new Adjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYGON, polyhedra, polyhedra, mesh->get_PolygonCollection());
+			auto csr = adjacency->get_adjacencySparseMatrix();
+
+			//Count, then fill, each interior face gives an entry to both of its cells
+			auto nbFace = static_cast<int>(transmissibility.size());
+			std::fill(csr->rowPtr.begin(), csr->rowPtr.end(), 0);
+			for (int face = 0; face != nbFace; ++face)
+			{
+				if (transmissibility.cell1[face] >= 0)
+				{
+					++csr->rowPtr[transmissibility.cell0[face] + 1];
+					++csr->rowPtr[transmissibility.cell1[face] + 1];
+				}
+			}
+			for (int i = 0; i != nbPolyhedron; ++i)
+			{
+				csr->rowPtr[i + 1] += csr->rowPtr[i];
+			}
+			csr->nnz = csr->rowPtr[nbPolyhedron];
+			csr->columnIndex.resize(csr->nnz);
+			csr->values.resize(csr->nnz);
+
+			std::vector<CSRMatrix::offset_type> position(csr->rowPtr.begin(), csr->rowPtr.end() - 1);
+			for (int face = 0; face != nbFace; ++face)
+			{
+				auto cell0 = transmissibility.cell0[face];
+				auto cell1 = transmissibility.cell1[face];
+				if (cell1 >= 0)
+				{
+					csr->columnIndex[position[cell0]] = cell1;
+					csr->values[position[cell0]++] = face;
+					csr->columnIndex[position[cell1]] = cell0;
+					csr->values[position[cell1]++] = face;
+				}
+			}
+			csr->sortRowIndexAndMoveValues();
+			csr->checkMatrix();
+
+			mesh->getAdjacencySet()->Add_NonTopologicalAdjacency(label, adjacency);
+			return adjacency;
+		}
+
+	}
+
+}
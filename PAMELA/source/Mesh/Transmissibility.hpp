@@ -0,0 +1,61 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+#include "Mesh/Mesh.hpp"
+
+namespace PAMELA
+{
+
+	class Adjacency;
+
+	/**
+	 * \brief Two-point flux approximation transmissibilities, stored as arrays indexed by the face local index
+	 * The two cells of a face are cell0 < cell1, cell1 is -1 for boundary faces.
+	 */
+	struct Transmissibility
+	{
+		std::vector<int> cell0, cell1;
+		std::vector<double> halfTransmissibility0, halfTransmissibility1;
+		std::vector<double> transmissibility;
+
+		void resize(size_t n)
+		{
+			cell0.resize(n, -1); cell1.resize(n, -1);
+			halfTransmissibility0.resize(n, 0); halfTransmissibility1.resize(n, 0);
+			transmissibility.resize(n, 0);
+		}
+		size_t size() const { return transmissibility.size(); }
+	};
+
+	namespace TPFA
+	{
+		/**
+		 * \brief Compute half and full transmissibilities of all faces from the face and cell geometry
+		 * Faces must have been created. Permeabilities are read from the PERMX, PERMY, PERMZ polyhedron properties,
+		 * PERMY and PERMZ default to PERMX and NTG, applied to the horizontal permeabilities, defaults to 1.
+		 * Faces are processed in parallel.
+		 */
+		void ComputeTransmissibility(Mesh* mesh, Transmissibility& transmissibility);
+
+		/**
+		 * \brief Cell to cell adjacency through interior faces, registered in the adjacency set of the mesh under label
+		 * Values are the face indices, transmissibilities of an entry are found with transmissibility.transmissibility[value].
+		 */
+		Adjacency* CreateAdjacency(Mesh* mesh, const std::string& label, const Transmissibility& transmissibility);
+	}
+
+}
@@ -127,26 +127,20 @@ namespace PAMELA
 				m_geoFile << (*it2)->get_globalIndex() << std::endl;
 			}
 
-			//--x
-			for (auto it2 = partptr->Points.begin(); it2 != partptr->Points.end(); ++it2)		//Loop over Points 
+			//--x, y and z, streamed from the point store, points that are not stored hold their own coordinates
+			const PointStore& store = m_mesh->get_PointStore();
+			auto writeComponent = [&](const std::vector<double>& component, double Coordinates::* member)
 			{
-				m_geoFile << std::setw(12);
-				m_geoFile << (*it2)->get_coordinates().x << std::endl;
-			}
-
-			//--y
-			for (auto it2 = partptr->Points.begin(); it2 != partptr->Points.end(); ++it2)		//Loop over Points 
-			{
-				m_geoFile << std::setw(12);
-				m_geoFile << (*it2)->get_coordinates().y << std::endl;
-			}
-
-			//--z
-			for (auto it2 = partptr->Points.begin(); it2 != partptr->Points.end(); ++it2)		//Loop over Points 
-			{
-				m_geoFile << std::setw(12);
-				m_geoFile << (*it2)->get_coordinates().z << std::endl;
-			}
+				for (size_t i = 0; i != partptr->Points.size(); ++i)
+				{
+					auto storeIndex = partptr->PointStoreIndex[i];
+					m_geoFile << std::setw(12);
+					m_geoFile << ((storeIndex >= 0) ? component[storeIndex] : partptr->Points[i]->get_coordinates().*member) << std::endl;
+				}
+			};
+			writeComponent(store.get_x(), &Coordinates::x);
+			writeComponent(store.get_y(), &Coordinates::y);
+			writeComponent(store.get_z(), &Coordinates::z);
 
 			//Elements
 
@@ -167,15 +161,14 @@ namespace PAMELA
 						m_geoFile << std::setw(10) << (*it3)->get_globalIndex() << std::endl;
 					}
 					//----Connectivity
-					for (auto it3 = subpart->SubCollection.begin_owned(); it3 != subpart->SubCollection.end_owned(); ++it3)
+					auto nVertex = subpart->Connectivity.size() / subpart->SubCollection.size_owned();
+					for (size_t j = 0; j != subpart->Connectivity.size(); ++j)
 					{
-						auto VertexList = (*it3)->get_vertexList();
-						auto nVertex = VertexList.size();
-						for (unsigned int j = 0; j != nVertex; ++j)
+						m_geoFile << std::setw(10) << subpart->Connectivity[j] + 1;
+						if ((j + 1) % nVertex == 0)
 						{
-							m_geoFile << std::setw(10) << partptr->GlobalToLocalPointMapping.at(VertexList[j]->get_globalIndex()) + 1;
+							m_geoFile << std::endl;
 						}
-						m_geoFile << std::endl;
 					}
 				}
 			}
@@ -29,7 +29,7 @@ namespace PAMELA {
   }
 
   template<typename T>
-    void FillParts(std::string prefixLabel, PartMap<T>* parts)
+    void FillParts(std::string prefixLabel, PartMap<T>* parts, PointCollection* points = nullptr, const CellConnectivity* connectivity = nullptr)
     {
       //--Iterate over parts
       for (auto it = parts->begin(); it != parts->end(); ++it)	//Loop over group and act on active groups
@@ -59,6 +59,11 @@ namespace PAMELA {
 
         //----Mapping from local to global
         int id = 0;
+        std::vector<int> PointToPart;
+        if (connectivity != nullptr)
+        {
+          PointToPart.assign(points->size_all(), -1);
+        }
         for (auto it2 = partptr->Collection->begin_owned(); it2 != partptr->Collection->end_owned(); ++it2)
         {
           auto vtkType = (*it2)->get_vtkType();
@@ -67,29 +72,84 @@ namespace PAMELA {
           subpart->IndexMapping.push_back(id);
           id++;
 
-          //std::set<Point*> PointsSet;
-
           //Insert vertices
-          auto vertexlist = (*it2)->get_vertexList();
-          int vertexsize = static_cast<int>(vertexlist.size());
-          for (auto i = 0; i != vertexsize; ++i)
+          if (connectivity != nullptr)
+          {
+            auto row = static_cast<size_t>((*it2)->get_localIndex());
+            for (auto vertex = connectivity->begin(row); vertex != connectivity->end(row); ++vertex)
+            {
+              ASSERT(*vertex != CellConnectivity::invalid_index, "Owned element with a vertex outside of the partition");
+              if (PointToPart[*vertex] == -1)
+              {
+                PointToPart[*vertex] = 0;
+                partptr->Points.push_back((*points)[*vertex]);
+              }
+            }
+          }
+          else
           {
-            partptr->Points.push_back(vertexlist[i]);
+            auto vertexlist = (*it2)->get_vertexList();
+            int vertexsize = static_cast<int>(vertexlist.size());
+            for (auto i = 0; i != vertexsize; ++i)
+            {
+              partptr->Points.push_back(vertexlist[i]);
+            }
           }
 
         }
 
-        std::sort(partptr->Points.begin(), partptr->Points.end());
-        partptr->Points.erase(std::unique(partptr->Points.begin(), partptr->Points.end()), partptr->Points.end());
+        if (connectivity != nullptr)
+        {
+          std::sort(partptr->Points.begin(), partptr->Points.end(), [](Point* lhs, Point* rhs) { return lhs->get_localIndex() < rhs->get_localIndex(); });
+        }
+        else
+        {
+          std::sort(partptr->Points.begin(), partptr->Points.end());
+          partptr->Points.erase(std::unique(partptr->Points.begin(), partptr->Points.end()), partptr->Points.end());
+        }
 
 
         //----Map Point Coordinates
         int i = 0;
+        std::vector<int> pointGlobalIndex; pointGlobalIndex.reserve(partptr->Points.size());
+        partptr->PointStoreIndex.reserve(partptr->Points.size());
         for (auto it2 = partptr->Points.begin(); it2 != partptr->Points.end(); ++it2)
         {
-          partptr->GlobalToLocalPointMapping[(*it2)->get_globalIndex()] = i;
+          pointGlobalIndex.push_back((*it2)->get_globalIndex());
+          partptr->PointStoreIndex.push_back((*it2)->get_storeIndex());
+          if (connectivity != nullptr)
+          {
+            PointToPart[(*it2)->get_localIndex()] = i;
+          }
           i++;
         }
+        partptr->GlobalToLocalPointMapping.build(pointGlobalIndex);
+
+        //----Flat connectivity in part numbering
+        for (auto it2 = partptr->SubParts.begin(); it2 != partptr->SubParts.end(); ++it2)
+        {
+          auto subpart = it2->second;
+          subpart->Connectivity.reserve(subpart->SubCollection.size_owned() * static_cast<size_t>(std::max(0, ELEMENTS::nVertexOf(static_cast<ELEMENTS::TYPE>(it2->first)))));
+          for (auto it3 = subpart->SubCollection.begin_owned(); it3 != subpart->SubCollection.end_owned(); ++it3)
+          {
+            if (connectivity != nullptr)
+            {
+              auto row = static_cast<size_t>((*it3)->get_localIndex());
+              for (auto vertex = connectivity->begin(row); vertex != connectivity->end(row); ++vertex)
+              {
+                subpart->Connectivity.push_back(PointToPart[*vertex]);
+              }
+            }
+            else
+            {
+              auto vertexlist = (*it3)->get_vertexList();
+              for (auto vertex : vertexlist)
+              {
+                subpart->Connectivity.push_back(partptr->GlobalToLocalPointMapping.at(vertex->get_globalIndex()));
+              }
+            }
+          }
+        }
 
       }
 
@@ -120,7 +180,7 @@ namespace PAMELA {
         partIndex++;
       }
     }
-    FillParts("PART" + PartitionNumberForExtension() + "_" + "POLYHEDRON", &partMap);
+    FillParts("PART" + PartitionNumberForExtension() + "_" + "POLYHEDRON", &partMap, mesh->get_PointCollection(), &mesh->get_PolyhedronConnectivity());
 
     auto mesh_props = mesh->get_PolyhedronProperty_double()->get_PropertyMap();
     for( auto& part : partMap )
@@ -175,7 +235,7 @@ namespace PAMELA {
         partIndex++;
       }
     }
-    FillParts("PART" + PartitionNumberForExtension() + "_" + "POLYGON", &partMap);
+    FillParts("PART" + PartitionNumberForExtension() + "_" + "POLYGON", &partMap, mesh->get_PointCollection(), &mesh->get_PolygonConnectivity());
     return std::make_pair(partMap, partIndex);
   }
 
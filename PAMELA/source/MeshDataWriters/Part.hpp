@@ -16,6 +16,7 @@
 // Library includes
 #include "Elements/Element.hpp"
 #include "Collection/Collection.hpp"
+#include "Utils/HashMap.hpp"
 #include "MeshDataWriters/Variable.hpp"
 
 #if defined( _WIN32)
@@ -35,6 +36,7 @@ namespace PAMELA
 		SubPart(int size, ELEMENTS::TYPE elementtype) { ElementType = elementtype; IndexMapping.reserve(size); SubCollection.reserve(size); }
 		ELEMENTS::TYPE ElementType;
 		std::vector<int> IndexMapping;  //Subpart to Part
+		std::vector<int> Connectivity;  //Vertices of the elements in part numbering, ElementType size per element
 		ElementEnsemble<T, ElementHash<T>, ElementEqual<T>> SubCollection;
 	};
 
@@ -42,7 +44,7 @@ namespace PAMELA
 	template <class T>
 	struct Part
 	{
-		Part(std::string label, int index, int localIndex, ElementEnsemble<T, ElementHash<T>, ElementEqual<T>>* collection) { Label = label; Collection = collection; Index = index; LocalIndex = localIndex; 
+		Part(std::string label, int index, int localIndex, ElementGroup<T>* collection) { Label = label; Collection = collection; Index = index; LocalIndex = localIndex; 
                 }
 		VariableDouble* AddVariable(VARIABLE_DIMENSION dim, VARIABLE_LOCATION dloc, std::string label)
 		{
@@ -76,9 +78,10 @@ namespace PAMELA
 		int Index;   // global including all families
                 int LocalIndex; // local index of this family
 		std::string Label;
-		ElementEnsemble<T, ElementHash<T>, ElementEqual<T>>* Collection;
+		ElementGroup<T>* Collection;
 		std::vector<Point*> Points;
-		std::unordered_map<int, int> GlobalToLocalPointMapping;
+		std::vector<PointHandle> PointStoreIndex;	//Position of each point in the mesh point store, -1 for a point that is not stored
+		utils::IndexMap GlobalToLocalPointMapping;
 		std::unordered_map<int, SubPart<T>*> SubParts;
 		std::unordered_map<int, int> numberOfElementsPerSubPart
 			=
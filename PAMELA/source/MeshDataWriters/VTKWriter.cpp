@@ -65,11 +65,21 @@ namespace PAMELA
             vtkSmartPointer<vtkUnstructuredGrid> ug = vtkUnstructuredGrid::New();
             vtkSmartPointer<vtkPoints> vertices = vtkPoints::New();
             auto partptr = it->second;
-            for (auto it2 = partptr->Points.begin(); it2 != partptr->Points.end(); ++it2) {
-                double point[3] = 
-                {(*it2)->get_coordinates().x, (*it2)->get_coordinates().y,
-                    (*it2)->get_coordinates().z};
-                vertices->InsertNextPoint(point);
+            //Coordinates are read from the point store, points that are not stored hold their own
+            const PointStore& store = m_mesh->get_PointStore();
+            const auto& x = store.get_x();
+            const auto& y = store.get_y();
+            const auto& z = store.get_z();
+            vertices->SetNumberOfPoints(static_cast<vtkIdType>(partptr->Points.size()));
+            for (size_t i = 0; i != partptr->Points.size(); ++i) {
+                auto storeIndex = partptr->PointStoreIndex[i];
+                if (storeIndex >= 0) {
+                    vertices->SetPoint(static_cast<vtkIdType>(i), x[storeIndex], y[storeIndex], z[storeIndex]);
+                }
+                else {
+                    auto coordinates = partptr->Points[i]->get_coordinates();
+                    vertices->SetPoint(static_cast<vtkIdType>(i), coordinates.x, coordinates.y, coordinates.z);
+                }
             }
             ug->SetPoints(vertices);
             for (auto it2 = partptr->SubParts.begin();it2 != partptr->SubParts.end(); ++it2)
@@ -81,17 +91,13 @@ namespace PAMELA
                     auto vtkTypeLabel = ElementToLabel.at(elementType);
                     std::vector<int> cell_types;
                     vtkSmartPointer<vtkCellArray> vtkcells= vtkCellArray::New();
-                    for (auto it3 = subpart->SubCollection.begin_owned(); it3 != subpart->SubCollection.end_owned(); ++it3)
+                    auto nCell = subpart->SubCollection.size_owned();
+                    auto nVertex = subpart->Connectivity.size() / nCell;
+                    cell_types.assign(nCell, vtkTypeLabel);
+                    std::vector<vtkIdType> corners(subpart->Connectivity.begin(), subpart->Connectivity.end());
+                    for (size_t j = 0; j != nCell; ++j)
                     {
-                        cell_types.emplace_back(vtkTypeLabel);
-                        auto VertexList = (*it3)->get_vertexList();
-                        auto nVertex = VertexList.size();
-	                    auto*corners = new vtkIdType[nVertex];
-                        for (size_t j = 0; j != nVertex; ++j)
-                        {
-                            corners[j] = partptr->GlobalToLocalPointMapping.at(VertexList[j]->get_globalIndex());
-                        }
-                        vtkcells->InsertNextCell(nVertex,corners);
+                        vtkcells->InsertNextCell(static_cast<vtkIdType>(nVertex), corners.data() + j * nVertex);
                     }
                     ug->SetCells(cell_types.data(),vtkcells);
                 }
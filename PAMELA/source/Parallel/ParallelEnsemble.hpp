@@ -18,6 +18,9 @@
 #include <set>
 #include <unordered_map>
 #include <iostream>
+#include <algorithm>
+#include "Parallel/PartitionFilter.hpp"
+#include "Utils/ParallelFor.hpp"
 
 namespace PAMELA
 {
@@ -73,17 +76,17 @@ namespace PAMELA
     //Iterators
     typedef typename std::vector<T>::iterator collection_iterator;
 
-    collection_iterator begin() { return m_data.begin(); }
-    collection_iterator end() { return m_data.end(); }
+    collection_iterator begin() { Compact(); return m_data.begin(); }
+    collection_iterator end() { Compact(); return m_data.end(); }
 
-    collection_iterator begin_owned() { return m_data.begin(); }
-    collection_iterator end_owned() { return m_data.begin() + size_owned(); }
+    collection_iterator begin_owned() { Compact(); return m_data.begin(); }
+    collection_iterator end_owned() { Compact(); return m_data.begin() + size_owned(); }
 
-    collection_iterator begin_ghost() { return m_data.begin() + size_owned(); }
-    collection_iterator end_ghost() { return m_data.end(); }
+    collection_iterator begin_ghost() { Compact(); return m_data.begin() + size_owned(); }
+    collection_iterator end_ghost() { Compact(); return m_data.end(); }
 
     //Operators
-    T &operator[](size_t i) { return m_data[i]; }
+    T &operator[](size_t i) { Compact(); return m_data[i]; }
 
     // T & AccessToElementDuringImport( size_t i)
     // {
@@ -98,30 +101,56 @@ namespace PAMELA
     // }
 
     //Push back T
+    //Owned elements added after ghosts are kept aside and moved in front of the ghosts in one pass on next access
     virtual void push_back_owned(T data)
     {
-      m_data.insert(this->end_owned(), data);
+      if ((m_sizeGhost == 0) && m_pendingOwned.empty())
+      {
+        m_data.push_back(data);
+      }
+      else
+      {
+        m_pendingOwned.push_back(data);
+      }
       Increment_owned();
     }
 
     virtual void push_back_ghost(T data)
     {
-      m_data.insert(this->end_ghost(), data);
+      m_data.push_back(data);
       Increment_ghost();
     }
 
     virtual void push_back_owned(std::vector<T> data)
     {
-      m_data.insert(this->end_owned(), data.begin(), data.end());
+      if ((m_sizeGhost == 0) && m_pendingOwned.empty())
+      {
+        m_data.insert(m_data.end(), data.begin(), data.end());
+      }
+      else
+      {
+        m_pendingOwned.insert(m_pendingOwned.end(), data.begin(), data.end());
+      }
       Increment_owned(data.size());
     }
 
     virtual void push_back_ghost(std::vector<T> data)
     {
-      m_data.insert(this->end_ghost(), data.begin(), data.end());
+      m_data.insert(m_data.end(), data.begin(), data.end());
       Increment_ghost(data.size());
     }
 
+    //Insert the pending owned elements between the owned and the ghost elements
+    void Compact()
+    {
+      if (m_pendingOwned.empty())
+      {
+        return;
+      }
+      m_data.insert(m_data.begin() + (m_sizeOwned - m_pendingOwned.size()), m_pendingOwned.begin(), m_pendingOwned.end());
+      m_pendingOwned.clear();
+    }
+
 
     virtual void MakeEmpty()
     {
@@ -129,39 +158,32 @@ namespace PAMELA
       m_sizeOwned = 0;
       m_sizeGhost = 0;
       m_data.clear();
+      m_pendingOwned.clear();
     }
 
 
-    //Shrink
-    virtual void Shrink(std::set<int> owned, std::set<int> ghost, int dimension = 1)
+    //Shrink to the items of a partition, item i being made of the dimension values starting at i*dimension
+    virtual void Shrink(const PartitionFilter& filter, int dimension = 1)
     {
-      //Copy ghost elements amd owned elements in temporary vector
-      std::vector<T> ghost_vec_temp; ghost_vec_temp.reserve(ghost.size() * dimension);
-      std::vector<T> owned_vec_temp; ghost_vec_temp.reserve(owned.size() * dimension);
-      for (auto it = m_data.begin(); it != m_data.end(); ++it)
-      {
-        if (ghost.count(static_cast<int>((it - m_data.begin())/ dimension)) == 1)
-        {
-          ghost_vec_temp.push_back(*it);
-        }
-        else if (owned.count(static_cast<int>(it - m_data.begin())/ dimension) == 1)
-        {
-          owned_vec_temp.push_back(*it);
-        }
-        else
-        {
-          //delete *it;  //TODO, need to delete dynamics objects but delete multiple time now. Smart pointer?
-          //*it = nullptr;
-        }
-      }
+      Compact();
+      Gather(filter.Select(m_data.size() / dimension, [](size_t i) { return static_cast<int>(i); }), dimension);
+    }
 
-      //Rebuilt data
-      m_data.clear();
-      m_data.reserve(ghost_vec_temp.size() * dimension + owned_vec_temp.size() * dimension);
-      m_data.insert(m_data.end(), owned_vec_temp.begin(), owned_vec_temp.end());
-      m_data.insert(m_data.end(), ghost_vec_temp.begin(), ghost_vec_temp.end());
-      resize_owned(static_cast<int>(owned_vec_temp.size() ));
-      resize_ghost(static_cast<int>(ghost_vec_temp.size() ));
+    //Keep the selected items, owned then ghosts
+    virtual void Gather(const PartitionSelection& selection, int dimension = 1)
+    {
+      Compact();
+      const size_t stride = static_cast<size_t>(dimension);
+      std::vector<T> data(selection.size() * stride);
+      auto& newToOld = selection.newToOld;
+      utils::parallel_for(0, static_cast<std::ptrdiff_t>(selection.size()), [&](std::ptrdiff_t i)
+      {
+        auto first = m_data.begin() + newToOld[i] * stride;
+        std::copy(first, first + stride, data.begin() + i * stride);
+      });
+      m_data.swap(data);
+      resize_owned(selection.nOwned * stride);
+      resize_ghost(selection.nGhost * stride);
 
       //Test for emptyness
       if (m_data.empty()) MakeEmpty();
@@ -169,13 +191,16 @@ namespace PAMELA
     }
 
     //Data
-    std::vector<T>& data_all() { return m_data; }
+    std::vector<T>& data_all() { Compact(); return m_data; }
 
   protected:
 
     //data
     std::vector<T> m_data;
 
+    //Owned elements waiting to be inserted before the ghosts
+    std::vector<T> m_pendingOwned;
+
     // Map from old element index to new for duplicate element
     // std::unordered_map< int, int> m_oldToNewIndex;
   };
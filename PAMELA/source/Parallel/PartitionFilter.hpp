@@ -0,0 +1,153 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "Utils/ParallelFor.hpp"
+#include "Utils/Assert.hpp"
+
+namespace PAMELA
+{
+
+	//Items kept on a partition: new position -> old position, owned items first then ghosts, both in their original order
+	struct PartitionSelection
+	{
+		std::vector<int> newToOld;
+		size_t nOwned = 0;
+		size_t nGhost = 0;
+
+		size_t size() const { return newToOld.size(); }
+
+		//Old position -> new position, -1 for removed items
+		std::vector<int> get_oldToNew(size_t nOld) const
+		{
+			std::vector<int> oldToNew(nOld, -1);
+			utils::parallel_for(0, static_cast<std::ptrdiff_t>(newToOld.size()), [&](std::ptrdiff_t i)
+			{
+				oldToNew[newToOld[i]] = static_cast<int>(i);
+			});
+			return oldToNew;
+		}
+	};
+
+	/**
+	 * \brief Dense owned/ghost flags of the elements of a family, indexed by global index.
+	 * An element flagged both owned and ghost is a ghost, an element that is not flagged is removed from the partition.
+	 */
+	class PartitionFilter
+	{
+	public:
+
+		enum STATUS : std::uint8_t { REMOVED = 0, OWNED = 1, GHOST = 2 };
+
+		explicit PartitionFilter(size_t n = 0) : m_flags(n, REMOVED) {}
+
+		//Setters
+		void set_owned(int i) { ASSERT(static_cast<size_t>(i) < m_flags.size(), "Index out of range"); m_flags[i] |= OWNED; }
+		void set_ghost(int i) { ASSERT(static_cast<size_t>(i) < m_flags.size(), "Index out of range"); m_flags[i] |= GHOST; }
+
+		//Getters
+		size_t size() const { return m_flags.size(); }
+
+		STATUS get_status(int i) const
+		{
+			if ((i < 0) || (static_cast<size_t>(i) >= m_flags.size()))
+			{
+				return REMOVED;
+			}
+			auto flag = m_flags[i];
+			return (flag & GHOST) ? GHOST : ((flag & OWNED) ? OWNED : REMOVED);
+		}
+
+		bool is_owned(int i) const { return get_status(i) == OWNED; }
+		bool is_ghost(int i) const { return get_status(i) == GHOST; }
+		bool is_kept(int i) const { return get_status(i) != REMOVED; }
+
+		/**
+		 * \brief Stable compaction of n items, the item at position i being filtered with the flag of key(i).
+		 * Items are counted per chunk, chunk offsets are scanned and each chunk is then scattered independently.
+		 */
+		template <class KeyFunction>
+		PartitionSelection Select(size_t n, KeyFunction&& key) const
+		{
+			const size_t nChunks = (n + chunkSize - 1) / chunkSize;
+			std::vector<std::uint8_t> status(n);
+			std::vector<size_t> ownedOffset(nChunks + 1, 0);
+			std::vector<size_t> ghostOffset(nChunks + 1, 0);
+
+			//Count
+			utils::parallel_for(0, static_cast<std::ptrdiff_t>(nChunks), [&](std::ptrdiff_t chunk)
+			{
+				size_t nOwned = 0, nGhost = 0;
+				const size_t first = static_cast<size_t>(chunk) * chunkSize;
+				const size_t last = std::min(n, first + chunkSize);
+				for (size_t i = first; i < last; ++i)
+				{
+					status[i] = get_status(key(i));
+					nOwned += (status[i] == OWNED);
+					nGhost += (status[i] == GHOST);
+				}
+				ownedOffset[chunk + 1] = nOwned;
+				ghostOffset[chunk + 1] = nGhost;
+			});
+
+			//Scan
+			for (size_t chunk = 0; chunk != nChunks; ++chunk)
+			{
+				ownedOffset[chunk + 1] += ownedOffset[chunk];
+				ghostOffset[chunk + 1] += ghostOffset[chunk];
+			}
+
+			PartitionSelection selection;
+			selection.nOwned = ownedOffset[nChunks];
+			selection.nGhost = ghostOffset[nChunks];
+			selection.newToOld.resize(selection.nOwned + selection.nGhost);
+
+			//Scatter
+			auto& newToOld = selection.newToOld;
+			const size_t nOwnedTotal = selection.nOwned;
+			utils::parallel_for(0, static_cast<std::ptrdiff_t>(nChunks), [&](std::ptrdiff_t chunk)
+			{
+				size_t owned = ownedOffset[chunk];
+				size_t ghost = nOwnedTotal + ghostOffset[chunk];
+				const size_t first = static_cast<size_t>(chunk) * chunkSize;
+				const size_t last = std::min(n, first + chunkSize);
+				for (size_t i = first; i < last; ++i)
+				{
+					if (status[i] == OWNED)
+					{
+						newToOld[owned++] = static_cast<int>(i);
+					}
+					else if (status[i] == GHOST)
+					{
+						newToOld[ghost++] = static_cast<int>(i);
+					}
+				}
+			});
+
+			return selection;
+		}
+
+	private:
+
+		static constexpr size_t chunkSize = 1 << 14;
+
+		std::vector<std::uint8_t> m_flags;
+
+	};
+
+}
@@ -68,12 +68,12 @@ namespace PAMELA
 
                 VARIABLE_DIMENSION GetProperty_dimension(const std::string& label) { return m_dimension.at(label); }
 
-		void ClearAfterPartitioning(std::set<int> owned, std::set<int> ghost)
+		void ClearAfterPartitioning(const PartitionFilter& filter)
 		{
 
 			for (auto it = m_data.begin(); it != m_data.end(); ++it)
 			{
-				it->second.Shrink(owned, ghost, static_cast<int>( m_dimension[it->first] ));
+				it->second.Shrink(filter, static_cast<int>( m_dimension[it->first] ));
 			}
 		}
 
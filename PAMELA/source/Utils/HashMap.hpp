@@ -17,6 +17,16 @@
 // Std library includes
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+// Project includes
+#include "Utils/Utils.hpp"
+#include "Utils/Logger.hpp"
 
 namespace PAMELA
 {
@@ -37,4 +47,268 @@ namespace PAMELA
 
 	template <typename Key, typename T>
 	using HashMultiMap = std::unordered_multimap<Key, T, HashType<Key>>;
+
+	namespace utils
+	{
+
+		/**
+		 * \brief Open-addressing hash map with linear probing.
+		 * Entries are stored inline in a single power-of-two array, inserting does not allocate once the map is reserved.
+		 * Erasing is not supported so that probing never has to skip tombstones, the map is cleared and rebuilt instead.
+		 */
+		template <class Key, class Value, class Hash = std::hash<Key>, class Equal = std::equal_to<Key>>
+		class FlatHashMap
+		{
+		public:
+
+			typedef std::pair<Key, Value> value_type;
+
+		private:
+
+			struct Slot
+			{
+				value_type data;
+				bool used;
+			};
+
+		public:
+
+			template <bool IsConst>
+			class Iterator
+			{
+			public:
+
+				typedef typename std::conditional<IsConst, const Slot*, Slot*>::type slot_pointer;
+				typedef typename std::conditional<IsConst, const value_type, value_type>::type reference_type;
+
+				Iterator(slot_pointer slot, slot_pointer last) : m_slot(slot), m_last(last) { skip(); }
+
+				reference_type& operator*() const { return m_slot->data; }
+				reference_type* operator->() const { return &m_slot->data; }
+				Iterator& operator++() { ++m_slot; skip(); return *this; }
+				bool operator==(const Iterator& rhs) const { return m_slot == rhs.m_slot; }
+				bool operator!=(const Iterator& rhs) const { return m_slot != rhs.m_slot; }
+
+			private:
+
+				void skip() { while ((m_slot != m_last) && (!m_slot->used)) { ++m_slot; } }
+
+				slot_pointer m_slot;
+				slot_pointer m_last;
+
+			};
+
+			typedef Iterator<false> iterator;
+			typedef Iterator<true> const_iterator;
+
+			FlatHashMap() = default;
+
+			//Capacity
+			size_t size() const { return m_size; }
+			bool empty() const { return m_size == 0; }
+
+			void reserve(size_t n)
+			{
+				size_t capacity = 8;
+				while (capacity * maxLoadNum < n * maxLoadDen)
+				{
+					capacity *= 2;
+				}
+				if (capacity > m_slots.size())
+				{
+					rehash(capacity);
+				}
+			}
+
+			//Remove all entries, the capacity is kept
+			void clear()
+			{
+				for (auto& slot : m_slots)
+				{
+					slot.used = false;
+				}
+				m_size = 0;
+			}
+
+			//Iterators
+			iterator begin() { return iterator(m_slots.data(), m_slots.data() + m_slots.size()); }
+			iterator end() { return iterator(m_slots.data() + m_slots.size(), m_slots.data() + m_slots.size()); }
+			const_iterator begin() const { return const_iterator(m_slots.data(), m_slots.data() + m_slots.size()); }
+			const_iterator end() const { return const_iterator(m_slots.data() + m_slots.size(), m_slots.data() + m_slots.size()); }
+
+			//Insert if the key is not present, returns the entry of the key and whether it has been inserted
+			std::pair<iterator, bool> insert(const value_type& value)
+			{
+				if ((m_size + 1) * maxLoadDen > m_slots.size() * maxLoadNum)
+				{
+					reserve(m_size + 1);
+				}
+				size_t i = probe(value.first);
+				bool inserted = !m_slots[i].used;
+				if (inserted)
+				{
+					m_slots[i].data = value;
+					m_slots[i].used = true;
+					++m_size;
+				}
+				return std::make_pair(iterator(m_slots.data() + i, m_slots.data() + m_slots.size()), inserted);
+			}
+
+			Value& operator[](const Key& key) { return insert(value_type(key, Value())).first->second; }
+
+			//Lookup
+			iterator find(const Key& key)
+			{
+				if (m_size == 0) return end();
+				size_t i = probe(key);
+				return m_slots[i].used ? iterator(m_slots.data() + i, m_slots.data() + m_slots.size()) : end();
+			}
+
+			const_iterator find(const Key& key) const
+			{
+				if (m_size == 0) return end();
+				size_t i = probe(key);
+				return m_slots[i].used ? const_iterator(m_slots.data() + i, m_slots.data() + m_slots.size()) : end();
+			}
+
+			size_t count(const Key& key) const { return (find(key) != end()) ? 1 : 0; }
+
+			const Value& at(const Key& key) const
+			{
+				auto it = find(key);
+				if (it == end())
+				{
+					LOGERROR("Key not found in hash map");
+				}
+				return it->second;
+			}
+
+		private:
+
+			//Maximum load factor maxLoadNum / maxLoadDen
+			static constexpr size_t maxLoadNum = 7;
+			static constexpr size_t maxLoadDen = 10;
+
+			//Slot holding the key, or the empty slot where it would be inserted
+			size_t probe(const Key& key) const
+			{
+				const size_t mask = m_slots.size() - 1;
+				size_t i = static_cast<size_t>(mixHash(static_cast<std::uint64_t>(Hash()(key)))) & mask;
+				while (m_slots[i].used && !Equal()(m_slots[i].data.first, key))
+				{
+					i = (i + 1) & mask;
+				}
+				return i;
+			}
+
+			void rehash(size_t capacity)
+			{
+				std::vector<Slot> slots(capacity, Slot{ value_type(), false });
+				slots.swap(m_slots);
+				for (auto& slot : slots)
+				{
+					if (slot.used)
+					{
+						m_slots[probe(slot.data.first)] = slot;
+					}
+				}
+			}
+
+			std::vector<Slot> m_slots;
+			size_t m_size = 0;
+
+		};
+
+		/**
+		 * \brief Map from integer ids to their position in a list, built in one pass.
+		 * Ids spanning a range at most twice as large as their number are stored in a dense array, others in a FlatHashMap.
+		 */
+		class IndexMap
+		{
+		public:
+
+			IndexMap() = default;
+
+			//Map keys[i] to i, a repeated key keeps its first position
+			void build(const std::vector<int>& keys)
+			{
+				clear();
+				if (keys.empty())
+				{
+					return;
+				}
+				auto range = std::minmax_element(keys.begin(), keys.end());
+				const size_t span = static_cast<size_t>(static_cast<std::int64_t>(*range.second) - *range.first) + 1;
+				m_dense = (span <= 2 * keys.size());
+				if (m_dense)
+				{
+					m_offset = *range.first;
+					m_positions.assign(span, -1);
+					for (size_t i = 0; i != keys.size(); ++i)
+					{
+						auto& position = m_positions[static_cast<size_t>(keys[i] - m_offset)];
+						if (position == -1)
+						{
+							position = static_cast<int>(i);
+							++m_size;
+						}
+					}
+				}
+				else
+				{
+					m_hash.reserve(keys.size());
+					for (size_t i = 0; i != keys.size(); ++i)
+					{
+						m_hash.insert(std::make_pair(keys[i], static_cast<int>(i)));
+					}
+					m_size = m_hash.size();
+				}
+			}
+
+			void clear()
+			{
+				m_positions.clear();
+				m_hash.clear();
+				m_offset = 0;
+				m_size = 0;
+				m_dense = true;
+			}
+
+			size_t size() const { return m_size; }
+
+			size_t count(int key) const
+			{
+				if (m_dense)
+				{
+					auto i = static_cast<std::int64_t>(key) - m_offset;
+					return ((i >= 0) && (i < static_cast<std::int64_t>(m_positions.size())) && (m_positions[static_cast<size_t>(i)] >= 0)) ? 1 : 0;
+				}
+				return m_hash.count(key);
+			}
+
+			int at(int key) const
+			{
+				if (m_dense)
+				{
+					if (count(key) == 0)
+					{
+						LOGERROR("Key not found in index map");
+					}
+					return m_positions[static_cast<size_t>(key - m_offset)];
+				}
+				return m_hash.at(key);
+			}
+
+		private:
+
+			bool m_dense = true;
+			int m_offset = 0;
+			size_t m_size = 0;
+			std::vector<int> m_positions;
+			FlatHashMap<int, int> m_hash;
+
+		};
+
+	}
+
 }
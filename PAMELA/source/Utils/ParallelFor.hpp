@@ -0,0 +1,106 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2019 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2019 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2019 Total, S.A
+ * Copyright (c) 2019-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace PAMELA
+{
+
+	namespace utils
+	{
+
+		//Number of threads used by parallel_for
+		inline int get_nbThreads()
+		{
+#ifdef WITH_OPENMP
+			return omp_get_max_threads();
+#else
+			return 1;
+#endif
+		}
+
+		//Index of the calling thread inside a parallel_for
+		inline int get_threadIndex()
+		{
+#ifdef WITH_OPENMP
+			return omp_get_thread_num();
+#else
+			return 0;
+#endif
+		}
+
+		/**
+		 * \brief Call function(i) for i in [begin,end), iterations are shared among threads when OpenMP is enabled
+		 * Iterations must be independent.
+		 */
+		template <class Function>
+		void parallel_for(std::ptrdiff_t begin, std::ptrdiff_t end, Function&& function)
+		{
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+			for (std::ptrdiff_t i = begin; i < end; ++i)
+			{
+				function(i);
+			}
+		}
+
+		/**
+		 * \brief Sort [first,last) with comp, chunks are sorted by different threads then merged pairwise
+		 * The sort is not stable, comp must give a strict weak ordering.
+		 */
+		template <class RandomIterator, class Compare>
+		void parallel_sort(RandomIterator first, RandomIterator last, Compare comp)
+		{
+			const std::ptrdiff_t n = last - first;
+			const std::ptrdiff_t minChunkSize = 1 << 14;
+			const std::ptrdiff_t nChunks = std::min<std::ptrdiff_t>(get_nbThreads(), n / minChunkSize);
+			if (nChunks <= 1)
+			{
+				std::sort(first, last, comp);
+				return;
+			}
+
+			std::vector<std::ptrdiff_t> bounds(nChunks + 1);
+			for (std::ptrdiff_t i = 0; i <= nChunks; ++i)
+			{
+				bounds[i] = n * i / nChunks;
+			}
+			parallel_for(0, nChunks, [&](std::ptrdiff_t i)
+			{
+				std::sort(first + bounds[i], first + bounds[i + 1], comp);
+			});
+
+			for (std::ptrdiff_t width = 1; width < nChunks; width *= 2)
+			{
+				parallel_for(0, (nChunks + 2 * width - 1) / (2 * width), [&](std::ptrdiff_t i)
+				{
+					auto lo = bounds[2 * i * width];
+					auto mid = bounds[std::min(2 * i * width + width, nChunks)];
+					auto hi = bounds[std::min(2 * i * width + 2 * width, nChunks)];
+					std::inplace_merge(first + lo, first + mid, first + hi, comp);
+				});
+			}
+		}
+
+	}
+
+}
@@ -28,6 +28,52 @@ namespace PAMELA
 
 
 
+	/**
+	 * \brief Fixed-size 3-vector
+	 */
+	struct Vec3
+	{
+		Vec3() :v{ 0, 0, 0 } {}
+		Vec3(double x, double y, double z) :v{ x, y, z } {}
+		explicit Vec3(const Coordinates& coord) :v{ coord.x, coord.y, coord.z } {}
+
+		double& operator[](int i) { return v[i]; }
+		double operator[](int i) const { return v[i]; }
+
+		Vec3& operator+=(const Vec3& other) { v[0] += other.v[0]; v[1] += other.v[1]; v[2] += other.v[2]; return *this; }
+		Vec3& operator*=(double alpha) { v[0] *= alpha; v[1] *= alpha; v[2] *= alpha; return *this; }
+
+		double v[3];
+	};
+
+	inline Vec3 operator+(Vec3 a, const Vec3& b) { return a += b; }
+	inline Vec3 operator-(const Vec3& a, const Vec3& b) { return Vec3(a[0] - b[0], a[1] - b[1], a[2] - b[2]); }
+	inline Vec3 operator*(double alpha, Vec3 a) { return a *= alpha; }
+
+	/**
+	 * \brief Fixed-size 3x3 matrix
+	 */
+	struct Mat3
+	{
+		Mat3() :m{ { 0, 0, 0 },{ 0, 0, 0 },{ 0, 0, 0 } } {}
+
+		double& operator()(int i, int j) { return m[i][j]; }
+		double operator()(int i, int j) const { return m[i][j]; }
+
+		//Column j
+		Vec3 column(int j) const { return Vec3(m[0][j], m[1][j], m[2][j]); }
+
+		double determinant() const
+		{
+			return m[0][0] * (m[1][1] * m[2][2] - m[2][1] * m[1][2])
+				- m[0][1] * (m[1][0] * m[2][2] - m[2][0] * m[1][2])
+				+ m[0][2] * (m[1][0] * m[2][1] - m[2][0] * m[1][1]);
+		}
+
+		double m[3][3];
+	};
+
+
 	inline int CoinToss(int i0, int i1)
 	{
 		if (i0 < i1)
@@ -50,4 +96,21 @@ namespace PAMELA
 		return std::sqrt(vec[0] * vec[0] + vec[1] * vec[1] + vec[2] * vec[2]);
 	}
 
+	inline Vec3 cross_product(const Vec3& vec1, const Vec3& vec2)
+	{
+		return Vec3(vec1[1] * vec2[2] - vec1[2] * vec2[1],
+			vec1[2] * vec2[0] - vec1[0] * vec2[2],
+			vec1[0] * vec2[1] - vec1[1] * vec2[0]);
+	}
+
+	inline double dot_product(const Vec3& vec1, const Vec3& vec2)
+	{
+		return vec1[0] * vec2[0] + vec1[1] * vec2[1] + vec1[2] * vec2[2];
+	}
+
+	inline double norm(const Vec3& vec)
+	{
+		return std::sqrt(dot_product(vec, vec));
+	}
+
 }
@@ -25,6 +25,7 @@
 #include <string>
 #include <sstream>
 #include <array>
+#include <cstdint>
 
 namespace PAMELA
 {
@@ -41,6 +42,15 @@ namespace PAMELA
                 return std::fabs(a - b) < epsilon;
             }
 
+		//64-bit finalizer of splitmix64, spreads regular integer keys over all bits
+		inline std::uint64_t mixHash(std::uint64_t h)
+		{
+			h ^= h >> 30; h *= 0xbf58476d1ce4e5b9ULL;
+			h ^= h >> 27; h *= 0x94d049bb133111ebULL;
+			h ^= h >> 31;
+			return h;
+		}
+
 		/* CUSTOM COPY FUNCTIONS */
 		// Call std::copy when iterator value type is the same for input and output and std::transform otherwise
 
@@ -0,0 +1,160 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "Parallel/Communicator.hpp"
+#include "Elements/ElementFactory.hpp"
+#include "gtest/gtest.h"
+
+using namespace PAMELA;
+
+//Count heap allocations while enabled, every form of operator new and delete is replaced so that they all pair with each other
+static std::atomic<bool> countAllocations(false);
+static std::atomic<size_t> nbAllocations(0);
+
+static void* allocate(std::size_t size)
+{
+    if (countAllocations)
+    {
+        ++nbAllocations;
+    }
+    if (void* memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+static void* allocate(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t& tag) noexcept { return allocate(size, tag); }
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return allocate(size, tag); }
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+
+#ifdef __cpp_aligned_new
+static void* allocate(std::size_t size, std::align_val_t alignment)
+{
+    if (countAllocations)
+    {
+        ++nbAllocations;
+    }
+    auto align = static_cast<std::size_t>(alignment);
+    size = (size == 0) ? align : (size + align - 1) / align * align;
+#ifdef _MSC_VER
+    if (void* memory = _aligned_malloc(size, align))
+#else
+    if (void* memory = std::aligned_alloc(align, size))
+#endif
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+static void deallocate(void* memory) noexcept
+{
+#ifdef _MSC_VER
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocate(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocate(size, alignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    try { return allocate(size, alignment); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    try { return allocate(size, alignment); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept { deallocate(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { deallocate(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { deallocate(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { deallocate(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(memory); }
+#endif
+
+int main(int argc, char **argv) {
+    Communicator::initialize();
+    ::testing::InitGoogleTest(&argc, argv);
+    int const result = RUN_ALL_TESTS();
+    Communicator::finalize();
+    return result;
+}
+
+TEST(testAllocation,testElementGeometry)
+{
+    const double hexa[8][3] = { {0,0,0}, {2,0,0}, {2,1,0}, {0,1,0}, {0,0,3}, {2,0,3}, {2,1,3}, {0,1,3} };
+    std::vector<Point*> points;
+    for (int i = 0; i != 8; ++i)
+    {
+        points.push_back(ElementFactory::makePoint(ELEMENTS::TYPE::VTK_VERTEX, i, hexa[i][0], hexa[i][1], hexa[i][2]));
+    }
+    auto hexahedron = ElementFactory::makePolyhedron(ELEMENTS::TYPE::VTK_HEXAHEDRON, 0, points);
+    auto tetrahedron = ElementFactory::makePolyhedron(ELEMENTS::TYPE::VTK_TETRA, 1, { points[0], points[1], points[3], points[4] });
+    auto quad = ElementFactory::makePolygon(ELEMENTS::TYPE::VTK_QUAD, 0, { points[0], points[1], points[2], points[3] });
+    auto triangle = ElementFactory::makePolygon(ELEMENTS::TYPE::VTK_TRIANGLE, 1, { points[0], points[1], points[2] });
+
+    double volume = 0, area = 0;
+    Vec3 centroid, normal;
+
+    nbAllocations = 0;
+    countAllocations = true;
+    for (int i = 0; i != 100; ++i)
+    {
+        volume += hexahedron->get_Volume() + tetrahedron->get_Volume();
+        centroid += hexahedron->get_centroidCoordinates();
+        centroid += tetrahedron->get_centroidCoordinates();
+        area += quad->get_SurfaceArea() + triangle->get_SurfaceArea();
+        centroid += quad->get_centroidCoordinates();
+        centroid += triangle->get_centroidCoordinates();
+        normal += quad->get_NormalVectorAndCoordinates().first;
+        normal += triangle->get_NormalVectorAndCoordinates().first;
+    }
+    countAllocations = false;
+
+    EXPECT_EQ(nbAllocations, 0u);
+    EXPECT_NEAR(volume, 100 * (6. + 1.), 1e-9);
+    EXPECT_NEAR(area, 100 * (2. + 1.), 1e-9);
+    EXPECT_NEAR(centroid[0], 100 * (1. + 0.5 + 1. + 4. / 3.), 1e-9);
+    EXPECT_NEAR(normal[2], 200., 1e-9);
+}
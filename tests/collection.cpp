@@ -0,0 +1,857 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <map>
+#include <cstdint>
+#include <random>
+
+#include "Parallel/Communicator.hpp"
+#include "Mesh/Mesh.hpp"
+#include "Collection/PointMerger.hpp"
+#include "Mesh/CartesianMesh.hpp"
+#include "Elements/FaceKey.hpp"
+#include "Elements/EdgeTable.hpp"
+#include "Utils/HashMap.hpp"
+#include "Parallel/ParallelEnsemble.hpp"
+#include "Parallel/PartitionFilter.hpp"
+#include "Elements/ElementFactory.hpp"
+#include "Adjacency/Adjacency.hpp"
+#include "gtest/gtest.h"
+
+using namespace PAMELA;
+
+int main(int argc, char **argv) {
+    Communicator::initialize();
+    ::testing::InitGoogleTest(&argc, argv);
+    int const result = RUN_ALL_TESTS();
+    Communicator::finalize();
+    return result;
+}
+
+TEST(testCollection,testPointMerger)
+{
+    PointStore store;
+    PointMerger merger(1e-6);
+
+    //Points on both sides of grid cell boundaries
+    std::vector<double> positions = { 0., 4e-6 - 1e-8, 1., -1. + 1e-9 };
+    for (auto x : positions)
+    {
+        merger.insert(store, store.push_back(x, -x, 2. * x));
+    }
+    EXPECT_EQ(merger.find(store, 0., 0., 0.), 0);
+    EXPECT_EQ(merger.find(store, 4e-6 + 1e-8, -4e-6 - 1e-8, 8e-6), 1);
+    EXPECT_EQ(merger.find(store, 1. - 5e-7, -1. + 5e-7, 2.), 2);
+    EXPECT_EQ(merger.find(store, -1. - 1e-9, 1., -2.), 3);
+    EXPECT_EQ(merger.find(store, 1. + 2e-6, -1., 2.), -1);
+    EXPECT_EQ(merger.find(store, 0.5, 0.5, 0.5), -1);
+
+    //The first inserted point wins when several are within tolerance
+    merger.insert(store, store.push_back(5e-7, 0., 0.));
+    EXPECT_EQ(merger.find(store, 4e-7, 0., 0.), 0);
+    EXPECT_EQ(merger.find(store, 1.2e-6, 0., 0.), 4);
+}
+
+TEST(testCollection,testMeshMergesPoints)
+{
+    Mesh mesh;
+    const int n = 100;
+    for (int pass = 0; pass != 2; ++pass)
+    {
+        int index = 0;
+        for (int k = 0; k != n; ++k)
+        {
+            for (int j = 0; j != n; ++j)
+            {
+                for (int i = 0; i != n; ++i)
+                {
+                    //Second pass is shifted by less than the tolerance
+                    double shift = (pass == 0) ? 0. : 3e-7;
+                    auto added = mesh.addPoint(ELEMENTS::TYPE::VTK_VERTEX, index, "POINT", 0.1 * i + shift, 0.1 * j - shift, 0.1 * k + shift);
+                    EXPECT_EQ(added.second, pass == 0);
+                    EXPECT_EQ(added.first->get_localIndex(), index);
+                    ++index;
+                }
+            }
+        }
+    }
+    EXPECT_EQ(mesh.get_PointCollection()->size_all(), static_cast<size_t>(n * n * n));
+    EXPECT_EQ(mesh.get_PointStore().size(), static_cast<size_t>(n * n * n));
+}
+
+TEST(testCollection,testPointView)
+{
+    //Stored points are views on the store, no coordinates of their own
+    static_assert(sizeof(Point) <= sizeof(ElementBase) + 2 * sizeof(void*), "A point is a store pointer and an index");
+    Mesh mesh;
+    auto stored = mesh.addPoint(ELEMENTS::TYPE::VTK_VERTEX, 0, "POINT", 1., 2., 3.).first;
+    EXPECT_EQ(stored->get_store(), &mesh.get_PointStore());
+    EXPECT_EQ(stored->get_storeIndex(), 0);
+    stored->set_coordinates(Coordinates(4., 5., 6.));
+    EXPECT_EQ(mesh.get_PointStore().get_y()[0], 5.);
+
+    //Detached points hold their coordinates until they are attached, then after being detached again
+    PointStore store;
+    auto point = ElementFactory::makePoint(ELEMENTS::TYPE::VTK_VERTEX, 1, 7., 8., 9.);
+    EXPECT_EQ(point->get_storeIndex(), -1);
+    EXPECT_EQ(point->get_coordinates().z, 9.);
+    point->AttachToStore(&store);
+    EXPECT_EQ(point->get_storeIndex(), 0);
+    EXPECT_EQ(store.get_x()[0], 7.);
+    point->set_coordinates(Coordinates(1., 1., 1.));
+    point->DetachFromStore();
+    EXPECT_EQ(point->get_storeIndex(), -1);
+    EXPECT_EQ(point->get_coordinates().x, 1.);
+    delete point;
+}
+
+TEST(testCollection,testFaceKey)
+{
+    Mesh mesh;
+    std::vector<Point*> points;
+    for (int i = 0; i != 5; ++i)
+    {
+        points.push_back(mesh.addPoint(ELEMENTS::TYPE::VTK_VERTEX, i, "POINT", i, i * i, 0.).first);
+    }
+
+    //Same face seen with rotated and reversed vertex order
+    FaceKey key({ points[0], points[1], points[2], points[3] });
+    EXPECT_EQ(key, FaceKey({ points[2], points[3], points[0], points[1] }));
+    EXPECT_EQ(key, FaceKey({ points[3], points[2], points[1], points[0] }));
+    EXPECT_EQ(FaceKeyHash()(key), FaceKeyHash()(FaceKey({ points[1], points[0], points[3], points[2] })));
+    EXPECT_NE(key, FaceKey({ points[0], points[1], points[2], points[4] }));
+    EXPECT_NE(key, FaceKey({ points[0], points[1], points[2] }));
+
+    //Faces shared by two cells are created once
+    const int n = 20;
+    CartesianMesh cartesian(std::vector<double>(n, 1.), std::vector<double>(n, 1.), std::vector<double>(n, 1.));
+    cartesian.CreateFacesFromCells();
+    EXPECT_EQ(cartesian.get_PolygonCollection()->size_all(), static_cast<size_t>(3 * n * n * (n + 1)));
+}
+
+TEST(testCollection,testHashMap)
+{
+    utils::FlatHashMap<int, int> map;
+    const int n = 100000;
+    for (int i = 0; i != n; ++i)
+    {
+        auto insertion = map.insert(std::make_pair(3 * i, i));
+        EXPECT_TRUE(insertion.second);
+    }
+    EXPECT_FALSE(map.insert(std::make_pair(3, 0)).second);
+    EXPECT_EQ(map.size(), static_cast<size_t>(n));
+    EXPECT_EQ(map.at(300), 100);
+    EXPECT_EQ(map.count(301), 0u);
+    map[301] = 7;
+    EXPECT_EQ(map.at(301), 7);
+
+    long long sum = 0;
+    for (auto& entry : map)
+    {
+        sum += entry.second;
+    }
+    EXPECT_EQ(sum, static_cast<long long>(n) * (n - 1) / 2 + 7);
+
+    //Dense and sparse index maps
+    utils::IndexMap dense, sparse;
+    dense.build({ 12, 10, 11, 14 });
+    sparse.build({ 1000000, 5, -3 });
+    EXPECT_EQ(dense.at(14), 3);
+    EXPECT_EQ(dense.count(13), 0u);
+    EXPECT_EQ(sparse.at(-3), 2);
+    EXPECT_EQ(sparse.at(1000000), 0);
+    EXPECT_EQ(sparse.count(6), 0u);
+
+    //Repeated keys keep their first position in both layouts, the size counts distinct keys
+    dense.build({ 3, 4, 3, 5 });
+    sparse.build({ 1000000, 5, 1000000 });
+    EXPECT_EQ(dense.at(3), 0);
+    EXPECT_EQ(dense.size(), 3u);
+    EXPECT_EQ(sparse.at(1000000), 0);
+    EXPECT_EQ(sparse.size(), 2u);
+}
+
+TEST(testCollection,testAddElements)
+{
+    ElementArena arena;
+    PointCollection collection(ELEMENTS::FAMILY::POINT);
+    std::vector<Point*> points;
+    for (int i = 0; i != 1000; ++i)
+    {
+        points.push_back(ElementFactory::makePoint(ELEMENTS::TYPE::VTK_VERTEX, i, i, 0., 0., &arena));
+    }
+
+    //Unchecked bulk insertion of new elements
+    auto groupA = collection.get_GroupIndex("A");
+    EXPECT_EQ(collection.AddElements(groupA, points.begin(), points.begin() + 600, false), 600u);
+    EXPECT_EQ(collection.size_all(), 600u);
+    EXPECT_EQ(points[599]->get_localIndex(), 599);
+    EXPECT_EQ(collection.get_Group("A")->size_all(), 600u);
+
+    //Checked insertion sees the elements added without check
+    EXPECT_FALSE(collection.AddElement("A", points[10]).second);
+    EXPECT_EQ(collection.AddElements(groupA, points.begin() + 500, points.end()), 400u);
+    EXPECT_EQ(collection.size_all(), 1000u);
+    EXPECT_EQ(collection.get_Group("A")->size_all(), 1000u);
+
+    //An existing element joins another group and keeps its index
+    auto returned = collection.AddElement("B", points[42]);
+    EXPECT_FALSE(returned.second);
+    EXPECT_EQ(returned.first, points[42]);
+    EXPECT_EQ(points[42]->get_localIndex(), 42);
+    EXPECT_EQ(collection.get_Group("B")->size_all(), 1u);
+    EXPECT_EQ(collection.get_GroupIndex("B"), groupA + 1);
+}
+
+TEST(testCollection,testGroups)
+{
+    ElementArena arena;
+    PointCollection collection(ELEMENTS::FAMILY::POINT);
+    std::vector<Point*> points;
+    for (int i = 0; i != 10; ++i)
+    {
+        points.push_back(ElementFactory::makePoint(ELEMENTS::TYPE::VTK_VERTEX, i, i, 0., 0., &arena));
+        collection.AddElement((i % 2 == 0) ? "EVEN" : "ODD", points.back());
+    }
+    collection.AddElement("LAST", points[9]);
+    collection.AddElement("LAST", points[3]);
+
+    auto even = collection.get_Group("EVEN");
+    EXPECT_EQ(even->size_all(), 5u);
+    EXPECT_TRUE(even->contains(4));
+    EXPECT_FALSE(even->contains(5));
+    auto last = collection.get_Group("LAST");
+    ASSERT_EQ(last->size_all(), 2u);
+    EXPECT_EQ((*last)[0], points[3]);
+    EXPECT_EQ(*(last->begin() + 1), points[9]);
+
+    //Groups follow the partitioning of the collection, ghosts come last
+    PartitionFilter filter(10);
+    for (int i : { 1, 2, 3, 4 }) filter.set_owned(i);
+    for (int i : { 8, 9 }) filter.set_ghost(i);
+    collection.ClearAfterPartitioning(filter);
+    EXPECT_EQ(collection.size_all(), 6u);
+    EXPECT_EQ(even->size_all(), 3u);
+    EXPECT_EQ(even->size_owned(), 2u);
+    EXPECT_EQ(even->size_ghost(), 1u);
+    std::vector<Point*> evenPoints(even->begin(), even->end());
+    EXPECT_EQ(evenPoints, std::vector<Point*>({ points[2], points[4], points[8] }));
+    EXPECT_EQ(last->size_owned(), 1u);
+    EXPECT_EQ(*last->begin_ghost(), points[9]);
+    EXPECT_EQ(collection.get_Group("ODD")->size_all(), 3u);
+}
+
+TEST(testCollection,testGroupsOwnedGhostAppend)
+{
+    //Owned elements appended after ghosts are moved in front of them, groups follow
+    ElementArena arena;
+    PointCollection collection(ELEMENTS::FAMILY::POINT);
+    std::vector<Point*> points;
+    for (int i = 0; i != 5; ++i)
+    {
+        points.push_back(ElementFactory::makePoint(ELEMENTS::TYPE::VTK_VERTEX, i, i, 0., 0., &arena));
+    }
+    collection.AddElement_owned("A", points[0]);
+    collection.AddElement_owned("A", points[1]);
+    collection.AddElement_ghost("A", points[2]);
+    collection.AddElement_ghost("A", points[3]);
+    collection.AddElement_ghost("B", points[3]);
+    collection.AddElement_owned("A", points[4]);
+    collection.AddElement_owned("B", points[4]);
+    collection.AddElement_ghost("B", points[2]);
+
+    std::vector<Point*> all(collection.begin(), collection.end());
+    EXPECT_EQ(all, std::vector<Point*>({ points[0], points[1], points[4], points[2], points[3] }));
+
+    auto groupA = collection.get_Group("A");
+    EXPECT_EQ(groupA->get_indices(), std::vector<int>({ 0, 1, 2, 3, 4 }));
+    EXPECT_EQ(groupA->size_owned(), 3u);
+    EXPECT_EQ(groupA->size_ghost(), 2u);
+    std::vector<Point*> membersA(groupA->begin(), groupA->end());
+    EXPECT_EQ(membersA, all);
+
+    auto groupB = collection.get_Group("B");
+    std::vector<Point*> membersB(groupB->begin(), groupB->end());
+    EXPECT_EQ(membersB, std::vector<Point*>({ points[4], points[2], points[3] }));
+    EXPECT_FALSE(groupB->contains(0));
+
+    //Later owned elements keep shifting the ghosts
+    auto extra = ElementFactory::makePoint(ELEMENTS::TYPE::VTK_VERTEX, 5, 5, 0., 0., &arena);
+    collection.AddElement_owned("B", extra);
+    std::vector<Point*> ghostsB(groupB->begin_ghost(), groupB->end_ghost());
+    EXPECT_EQ(ghostsB, std::vector<Point*>({ points[2], points[3] }));
+    EXPECT_EQ(groupB->get_indices(), std::vector<int>({ 2, 3, 4, 5 }));
+    EXPECT_EQ(groupA->get_indices(), std::vector<int>({ 0, 1, 2, 4, 5 }));
+}
+
+namespace
+{
+    //Item counting its copies, to check how many times an ensemble moves its data
+    struct CountedItem
+    {
+        static size_t nbCopies;
+        int value;
+        CountedItem() : value(0) {}
+        CountedItem(int v) : value(v) {}
+        CountedItem(const CountedItem& other) : value(other.value) { ++nbCopies; }
+        CountedItem& operator=(const CountedItem& other) { value = other.value; ++nbCopies; return *this; }
+        bool operator==(const CountedItem& other) const { return value == other.value; }
+    };
+    size_t CountedItem::nbCopies = 0;
+}
+
+TEST(testCollection,testOwnedGhostAppend)
+{
+    //Interleaved owned and ghost insertions, owned elements must come first in insertion order
+    auto fill = [](ParallelEnsemble<int>& ensemble, int n)
+    {
+        for (int i = 0; i != n; ++i)
+        {
+            ensemble.push_back_owned(i);
+            ensemble.push_back_ghost(-i - 1);
+        }
+        ensemble.push_back_owned(std::vector<int>({ n, n + 1 }));
+    };
+
+    ParallelEnsemble<int> small;
+    fill(small, 3);
+    std::vector<int> smallData(small.begin(), small.end());
+    EXPECT_EQ(smallData, std::vector<int>({ 0, 1, 2, 3, 4, -1, -2, -3 }));
+    EXPECT_EQ(small.size_owned(), 5u);
+    EXPECT_EQ(*small.begin_ghost(), -1);
+    small.push_back_ghost(-4);
+    small.push_back_owned(5);
+    EXPECT_EQ(small[5], 5);
+    EXPECT_EQ(small[9], -4);
+
+    //Appends are linear: the items are copied a bounded number of times, whereas inserting each owned item before the ghosts would copy them quadratically often
+    const int n = 20000;
+    ParallelEnsemble<CountedItem> ensemble;
+    CountedItem::nbCopies = 0;
+    for (int i = 0; i != n; ++i)
+    {
+        ensemble.push_back_owned(CountedItem(i));
+        ensemble.push_back_ghost(CountedItem(-i - 1));
+    }
+    EXPECT_EQ(ensemble[n - 1], CountedItem(n - 1));
+    EXPECT_EQ(*ensemble.begin_ghost(), CountedItem(-1));
+    EXPECT_EQ(*(ensemble.end() - 1), CountedItem(-n));
+    EXPECT_LE(CountedItem::nbCopies, static_cast<size_t>(10 * 2 * n));
+}
+
+TEST(testCollection,testPartitionFilter)
+{
+    //Selection spans several chunks, owned items come first then ghosts, both in their original order
+    const int n = 100000;
+    PartitionFilter filter(n);
+    for (int i = 0; i < n; i += 3) filter.set_owned(i);
+    for (int i = 1; i < n; i += 7) filter.set_ghost(i);
+    filter.set_owned(8);
+    EXPECT_TRUE(filter.is_ghost(8));
+    EXPECT_FALSE(filter.is_kept(2));
+    EXPECT_FALSE(filter.is_kept(n));
+
+    auto selection = filter.Select(n, [](size_t i) { return static_cast<int>(i); });
+    std::vector<int> expected;
+    for (int i = 0; i < n; ++i) if (filter.is_owned(i)) expected.push_back(i);
+    EXPECT_EQ(selection.nOwned, expected.size());
+    for (int i = 0; i < n; ++i) if (filter.is_ghost(i)) expected.push_back(i);
+    EXPECT_EQ(selection.newToOld, expected);
+    auto oldToNew = selection.get_oldToNew(n);
+    EXPECT_EQ(oldToNew[2], -1);
+    EXPECT_EQ(oldToNew[expected.back()], static_cast<int>(expected.size()) - 1);
+
+    //Properties keep the values of each item together
+    ParallelEnsemble<double> property;
+    property.push_back_owned(std::vector<double>({ 0., 0.5, 1., 1.5, 2., 2.5, 3., 3.5 }));
+    PartitionFilter propertyFilter(4);
+    propertyFilter.set_ghost(0);
+    propertyFilter.set_owned(2);
+    property.Shrink(propertyFilter, 2);
+    std::vector<double> values(property.begin(), property.end());
+    EXPECT_EQ(values, std::vector<double>({ 2., 2.5, 0., 0.5 }));
+    EXPECT_EQ(property.size_owned(), 2u);
+    EXPECT_EQ(property.size_ghost(), 2u);
+}
+
+TEST(testCollection,testFaceExtraction)
+{
+    //Hexahedron with a pyramid on top, a wedge on its side and a tetrahedron on a pyramid face
+    Mesh mesh;
+    const double coordinates[12][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 },
+                                        { 0.5, 0.5, 2 }, { 2, 0.5, 0 }, { 2, 0.5, 1 }, { 0.5, -1, 1.5 } };
+    std::vector<Point*> p;
+    for (int i = 0; i != 12; ++i)
+    {
+        p.push_back(mesh.addPoint(ELEMENTS::TYPE::VTK_VERTEX, i, "POINT", coordinates[i][0], coordinates[i][1], coordinates[i][2]).first);
+    }
+    mesh.addPolygon(ELEMENTS::TYPE::VTK_QUAD, 0, "Bottom", { p[3], p[2], p[1], p[0] });
+    mesh.addPolyhedron(ELEMENTS::TYPE::VTK_HEXAHEDRON, 0, "POLYHEDRON_GROUP_1", { p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7] });
+    mesh.addPolyhedron(ELEMENTS::TYPE::VTK_PYRAMID, 1, "POLYHEDRON_GROUP_1", { p[4], p[5], p[6], p[7], p[8] });
+    mesh.addPolyhedron(ELEMENTS::TYPE::VTK_WEDGE, 2, "POLYHEDRON_GROUP_1", { p[1], p[2], p[9], p[5], p[6], p[10] });
+    mesh.addPolyhedron(ELEMENTS::TYPE::VTK_TETRA, 3, "POLYHEDRON_GROUP_1", { p[4], p[5], p[8], p[11] });
+    mesh.CreateFacesFromCells();
+
+    auto polygons = mesh.get_PolygonCollection();
+    auto polyhedra = mesh.get_PolyhedronCollection();
+    ASSERT_EQ(polygons->size_all(), 17u);
+    EXPECT_EQ(polygons->get_Group("Bottom")->size_all(), 1u);
+    EXPECT_EQ(polygons->get_Group("BOUNDARY")->size_all(), 14u);
+    EXPECT_TRUE(mesh.get_BoundaryPolygons()[0]);
+
+    //Same faces as the element interface, the existing polygon is reused and new faces keep the orientation of their first cell
+    std::unordered_map<FaceKey, int, FaceKeyHash> polygonIndex;
+    for (size_t i = 0; i != polygons->size_all(); ++i)
+    {
+        EXPECT_EQ((*polygons)[i]->get_localIndex(), static_cast<int>(i));
+        EXPECT_TRUE(polygonIndex.insert(std::make_pair(FaceKey((*polygons)[i]->get_vertexList()), static_cast<int>(i))).second);
+    }
+    auto cellToFace = mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON);
+    std::vector<bool> seen(polygons->size_all(), false);
+    seen[0] = true;
+    for (size_t i = 0; i != polyhedra->size_all(); ++i)
+    {
+        ElementArena arena;
+        auto faces = (*polyhedra)[i]->CreateFaces(&arena);
+        std::vector<int> expected;
+        for (auto face : faces)
+        {
+            ASSERT_EQ(polygonIndex.count(FaceKey(face->get_vertexList())), 1u);
+            auto index = polygonIndex.at(FaceKey(face->get_vertexList()));
+            if (!seen[index])
+            {
+                EXPECT_EQ((*polygons)[index]->get_vertexList(), face->get_vertexList());
+                EXPECT_EQ((*polygons)[index]->get_vtkType(), face->get_vtkType());
+                seen[index] = true;
+            }
+            expected.push_back(index);
+        }
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(cellToFace->get_SingleElementAdjacency(static_cast<int>(i)).first, expected);
+        EXPECT_EQ(cellToFace->get_SingleElementAdjacency(static_cast<int>(i)).second, std::vector<int>(expected.size(), static_cast<int>(i)));
+    }
+
+    //Face to cell is built in the same pass and matches the transpose
+    auto faceToCell = mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYHEDRON);
+    auto transposed = CSRMatrix::transpose(cellToFace->get_adjacencySparseMatrix());
+    EXPECT_EQ(faceToCell->get_adjacencySparseMatrix()->rowPtr, transposed->rowPtr);
+    EXPECT_EQ(faceToCell->get_adjacencySparseMatrix()->columnIndex, transposed->columnIndex);
+    EXPECT_EQ(faceToCell->get_adjacencySparseMatrix()->values, transposed->values);
+    EXPECT_EQ(faceToCell->get_SingleElementAdjacency(0).first, std::vector<int>({ 0 }));
+    delete transposed;
+}
+
+TEST(testCollection,testCSRMatrixTypes)
+{
+    static_assert(sizeof(CSRMatrix::offset_type) == 8, "Adjacency matrices use 64-bit offsets");
+
+    const int n = 5;
+    CartesianMesh mesh(std::vector<double>(n, 1.), std::vector<double>(n, 1.), std::vector<double>(n, 1.));
+    mesh.CreateFacesFromCells();
+    auto cellToFace = mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON)->get_adjacencySparseMatrix();
+    auto faceToCell = mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYHEDRON)->get_adjacencySparseMatrix();
+
+    //Cell to cell graph computed with other offset and index types
+    auto graph = CSRMatrix::product(cellToFace, faceToCell);
+    auto graph32 = CSRMatrixT<int, int>::product(cellToFace, faceToCell);
+    auto graph64 = CSRMatrixT<std::int64_t, std::int64_t>::product(cellToFace, faceToCell);
+    ASSERT_EQ(graph->nnz, static_cast<std::int64_t>(n * n * n + 6 * n * n * (n - 1)));
+    EXPECT_EQ(graph32->nnz, graph->nnz);
+    EXPECT_EQ(graph64->nnz, graph->nnz);
+    EXPECT_EQ(graph->rowPtr, std::vector<std::int64_t>(graph32->rowPtr.begin(), graph32->rowPtr.end()));
+    EXPECT_EQ(graph->rowPtr, graph64->rowPtr);
+    EXPECT_EQ(graph->columnIndex, graph32->columnIndex);
+    EXPECT_EQ(std::vector<std::int64_t>(graph->columnIndex.begin(), graph->columnIndex.end()), graph64->columnIndex);
+    EXPECT_EQ(std::vector<std::int64_t>(graph->values.begin(), graph->values.end()), graph64->values);
+
+    //Transposes agree
+    auto transposed = CSRMatrix::transpose(graph);
+    auto transposed64 = CSRMatrixT<std::int64_t, std::int64_t>::transpose(graph64);
+    EXPECT_EQ(transposed->rowPtr, transposed64->rowPtr);
+    EXPECT_EQ(std::vector<std::int64_t>(transposed->columnIndex.begin(), transposed->columnIndex.end()), transposed64->columnIndex);
+    delete graph; delete graph32; delete graph64; delete transposed; delete transposed64;
+}
+
+namespace
+{
+    //Former single pass product: capacity guessed from the operands, rows sorted afterwards
+    CSRMatrix* legacyProduct(const CSRMatrix* lhs, const CSRMatrix* rhs)
+    {
+        auto nr = lhs->dimRow;
+        auto mult = new CSRMatrix(nr, nr, (lhs->nnz + rhs->nnz) * 10);
+        std::vector<std::int64_t> iw(mult->nnz, -1);
+        std::int64_t len = -1;
+        for (int ii = 0; ii < nr; ++ii)
+        {
+            for (auto ka = lhs->rowPtr[ii]; ka < lhs->rowPtr[ii + 1]; ++ka)
+            {
+                int jj = lhs->columnIndex[ka];
+                for (auto kb = rhs->rowPtr[jj]; kb < rhs->rowPtr[jj + 1]; ++kb)
+                {
+                    int jcol = rhs->columnIndex[kb];
+                    if (iw[jcol] == -1)
+                    {
+                        ++len;
+                        mult->columnIndex[len] = jcol;
+                        iw[jcol] = len;
+                    }
+                    mult->values[iw[jcol]] = (ii == jcol) ? -1 : jj;
+                }
+            }
+            for (auto k = mult->rowPtr[ii]; k < len + 1; ++k)
+            {
+                iw[mult->columnIndex[k]] = -1;
+            }
+            mult->rowPtr[ii + 1] = len + 1;
+        }
+        mult->nnz = len + 1;
+        mult->shrink();
+        mult->sortRowIndexAndMoveValues();
+        return mult;
+    }
+
+    //Former serial counting sort transpose
+    CSRMatrix* legacyTranspose(const CSRMatrix* matrix)
+    {
+        auto trans = new CSRMatrix(matrix->dimColumn, matrix->dimRow, matrix->nnz);
+        for (auto k = 0; k < matrix->nnz; ++k)
+        {
+            ++trans->rowPtr[matrix->columnIndex[k] + 1];
+        }
+        for (int i = 0; i < trans->dimRow; ++i)
+        {
+            trans->rowPtr[i + 1] += trans->rowPtr[i];
+        }
+        std::vector<std::int64_t> next(trans->rowPtr.begin(), trans->rowPtr.end() - 1);
+        for (int row = 0; row < matrix->dimRow; ++row)
+        {
+            for (auto k = matrix->rowPtr[row]; k < matrix->rowPtr[row + 1]; ++k)
+            {
+                auto position = next[matrix->columnIndex[k]]++;
+                trans->columnIndex[position] = row;
+                trans->values[position] = matrix->values[k];
+            }
+        }
+        return trans;
+    }
+}
+
+TEST(testCollection,testSparseProduct)
+{
+    const int n = 40;
+    CartesianMesh mesh(std::vector<double>(n, 1.), std::vector<double>(n, 1.), std::vector<double>(n, 1.));
+    mesh.CreateFacesFromCells();
+    auto cellToFace = mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON)->get_adjacencySparseMatrix();
+    auto faceToCell = mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYHEDRON)->get_adjacencySparseMatrix();
+
+    auto expected = legacyProduct(cellToFace, faceToCell);
+    auto graph = CSRMatrix::product(cellToFace, faceToCell);
+
+    //Same graph, allocated exactly
+    EXPECT_EQ(graph->dimRow, n * n * n);
+    EXPECT_EQ(graph->dimColumn, n * n * n);
+    EXPECT_EQ(graph->nnz, expected->nnz);
+    EXPECT_EQ(graph->rowPtr, expected->rowPtr);
+    EXPECT_EQ(graph->columnIndex, expected->columnIndex);
+    EXPECT_EQ(graph->values, expected->values);
+    EXPECT_EQ(graph->columnIndex.size(), static_cast<size_t>(graph->nnz));
+
+    //Rectangular product
+    auto faceToFace = CSRMatrix::product(faceToCell, cellToFace);
+    EXPECT_EQ(faceToFace->dimRow, faceToCell->dimRow);
+    EXPECT_EQ(faceToFace->dimColumn, cellToFace->dimColumn);
+    EXPECT_TRUE(faceToFace->checkMatrix());
+
+    delete expected; delete graph; delete faceToFace;
+}
+
+//Former and two-pass products of the cell to cell graph, run with --gtest_also_run_disabled_tests
+TEST(testCollection,DISABLED_benchmarkSparseProduct)
+{
+    const int n = 60;
+    CartesianMesh mesh(std::vector<double>(n, 1.), std::vector<double>(n, 1.), std::vector<double>(n, 1.));
+    mesh.CreateFacesFromCells();
+    auto cellToFace = mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON)->get_adjacencySparseMatrix();
+    auto faceToCell = mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYHEDRON)->get_adjacencySparseMatrix();
+
+    auto start = std::chrono::steady_clock::now();
+    auto expected = legacyProduct(cellToFace, faceToCell);
+    auto middle = std::chrono::steady_clock::now();
+    auto graph = CSRMatrix::product(cellToFace, faceToCell);
+    auto end = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(graph->rowPtr, expected->rowPtr);
+    EXPECT_EQ(graph->columnIndex, expected->columnIndex);
+
+    std::cout << "Cell to cell product: " << std::chrono::duration<double>(middle - start).count() << "s former, "
+              << std::chrono::duration<double>(end - middle).count() << "s two-pass" << std::endl;
+    delete expected; delete graph;
+}
+
+TEST(testCollection,testDualGraph)
+{
+    const int n = 40;
+    CartesianMesh mesh(std::vector<double>(n, 1.), std::vector<double>(n, 1.), std::vector<double>(n, 1.));
+    mesh.CreateFacesFromCells();
+    auto cellToFace = mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON)->get_adjacencySparseMatrix();
+    auto faceToCell = mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYHEDRON)->get_adjacencySparseMatrix();
+
+    auto product = CSRMatrix::product(cellToFace, faceToCell);
+    auto graph = CSRMatrix::dualGraph(faceToCell);
+
+    //Product without its diagonal
+    CSRMatrix expected(product->dimRow, product->dimColumn);
+    for (int i = 0; i != product->dimRow; ++i)
+    {
+        for (auto k = product->rowPtr[i]; k != product->rowPtr[i + 1]; ++k)
+        {
+            if (product->columnIndex[k] != i)
+            {
+                expected.columnIndex.push_back(product->columnIndex[k]);
+                expected.values.push_back(product->values[k]);
+            }
+        }
+        expected.rowPtr[i + 1] = static_cast<CSRMatrix::offset_type>(expected.columnIndex.size());
+    }
+    EXPECT_EQ(graph->dimRow, n * n * n);
+    EXPECT_EQ(graph->dimColumn, n * n * n);
+    EXPECT_EQ(graph->nnz, static_cast<CSRMatrix::offset_type>(6 * n * n * (n - 1)));
+    EXPECT_EQ(graph->rowPtr, expected.rowPtr);
+    EXPECT_EQ(graph->columnIndex, expected.columnIndex);
+    EXPECT_EQ(graph->values, expected.values);
+
+    //Registered cell to cell adjacency
+    auto cellToCell = mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYGON);
+    EXPECT_EQ(cellToCell->get_targetElementCollection(), mesh.get_PolyhedronCollection());
+    EXPECT_EQ(cellToCell->get_adjacencySparseMatrix()->columnIndex, graph->columnIndex);
+
+    //Columns linked by several rows keep the last one, rows may link more than two columns
+    CSRMatrix rows(3, 4);
+    rows.rowPtr = { 0, 2, 5, 6 };
+    rows.columnIndex = { 0, 1, 1, 0, 3, 2 };
+    rows.values = { 0, 0, 1, 1, 1, 2 };
+    rows.nnz = 6;
+    auto small = CSRMatrix::dualGraph(&rows);
+    EXPECT_EQ(small->rowPtr, std::vector<CSRMatrix::offset_type>({ 0, 2, 4, 4, 6 }));
+    EXPECT_EQ(small->columnIndex, std::vector<int>({ 1, 3, 0, 3, 0, 1 }));
+    EXPECT_EQ(small->values, std::vector<int>({ 1, 1, 1, 1, 1, 1 }));
+    EXPECT_EQ(small->nnz, 6);
+
+    delete product; delete graph; delete small;
+}
+
+TEST(testCollection,testTranspose)
+{
+    const int n = 40;
+    CartesianMesh mesh(std::vector<double>(n, 1.), std::vector<double>(n, 1.), std::vector<double>(n, 1.));
+    auto cellToPoint = mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POINT, ELEMENTS::FAMILY::POLYHEDRON)->get_adjacencySparseMatrix();
+
+    auto expected = legacyTranspose(cellToPoint);
+    auto pointToCell = CSRMatrix::transpose(cellToPoint);
+
+    //Identical to the serial transpose, whatever the number of threads
+    EXPECT_EQ(pointToCell->dimRow, (n + 1) * (n + 1) * (n + 1));
+    EXPECT_EQ(pointToCell->dimColumn, n * n * n);
+    EXPECT_EQ(pointToCell->nnz, expected->nnz);
+    EXPECT_EQ(pointToCell->rowPtr, expected->rowPtr);
+    EXPECT_EQ(pointToCell->columnIndex, expected->columnIndex);
+    EXPECT_EQ(pointToCell->values, expected->values);
+
+    //Back to the original matrix
+    auto back = CSRMatrix::transpose(pointToCell);
+    EXPECT_EQ(back->rowPtr, cellToPoint->rowPtr);
+    EXPECT_EQ(back->columnIndex, cellToPoint->columnIndex);
+    EXPECT_EQ(back->values, cellToPoint->values);
+
+    //Few dense columns, each row of the transpose gathers entries from every thread
+    std::mt19937 generator(3);
+    const int nRow = 20000;
+    const int nColumn = 64;
+    CSRMatrix dense(nRow, nColumn);
+    for (int i = 0; i != nRow; ++i)
+    {
+        for (int j = 0; j != nColumn; ++j)
+        {
+            if (generator() % 4 == 0)
+            {
+                dense.columnIndex.push_back(j);
+                dense.values.push_back(i + j);
+            }
+        }
+        dense.rowPtr[i + 1] = static_cast<CSRMatrix::offset_type>(dense.columnIndex.size());
+    }
+    dense.nnz = dense.rowPtr[nRow];
+    auto denseExpected = legacyTranspose(&dense);
+    auto denseTranspose = CSRMatrix::transpose(&dense);
+    EXPECT_EQ(denseTranspose->rowPtr, denseExpected->rowPtr);
+    EXPECT_EQ(denseTranspose->columnIndex, denseExpected->columnIndex);
+    EXPECT_EQ(denseTranspose->values, denseExpected->values);
+
+    delete expected; delete pointToCell; delete back; delete denseExpected; delete denseTranspose;
+}
+
+TEST(testCollection,testRowSort)
+{
+    //Rows of every length up to the std::sort fallback, distinct columns in random order, the value follows its column
+    std::mt19937 generator(7);
+    const int nRow = 200;
+    CSRMatrix matrix(nRow, 1000);
+    std::vector<std::vector<std::pair<int, int>>> expected(nRow);
+    for (int i = 0; i != nRow; ++i)
+    {
+        std::vector<int> columns(1000);
+        for (int j = 0; j != 1000; ++j)
+        {
+            columns[j] = j;
+        }
+        std::shuffle(columns.begin(), columns.end(), generator);
+        columns.resize(i % 50);
+        for (auto column : columns)
+        {
+            matrix.columnIndex.push_back(column);
+            matrix.values.push_back(3 * column + 1);
+            expected[i].push_back(std::make_pair(column, 3 * column + 1));
+        }
+        std::sort(expected[i].begin(), expected[i].end());
+        matrix.rowPtr[i + 1] = static_cast<CSRMatrix::offset_type>(matrix.columnIndex.size());
+    }
+    matrix.nnz = matrix.rowPtr[nRow];
+
+    //Single row, then the whole matrix
+    matrix.sortRowIndexAndMoveValues(8);
+    for (auto k = matrix.rowPtr[8]; k != matrix.rowPtr[9]; ++k)
+    {
+        EXPECT_EQ(matrix.columnIndex[k], expected[8][k - matrix.rowPtr[8]].first);
+    }
+    matrix.sortRowIndexAndMoveValues();
+    for (int i = 0; i != nRow; ++i)
+    {
+        for (auto k = matrix.rowPtr[i]; k != matrix.rowPtr[i + 1]; ++k)
+        {
+            EXPECT_EQ(matrix.columnIndex[k], expected[i][k - matrix.rowPtr[i]].first);
+            EXPECT_EQ(matrix.values[k], expected[i][k - matrix.rowPtr[i]].second);
+        }
+    }
+
+    //Sorted rows are kept as they are
+    auto sorted = matrix.columnIndex;
+    matrix.sortRowIndexAndMoveValues();
+    EXPECT_EQ(matrix.columnIndex, sorted);
+}
+
+TEST(testCollection,testBoundaryFaces)
+{
+    const int n = 6;
+    for (auto implicitInteriorFaces : { false, true })
+    {
+        CartesianMesh mesh(std::vector<double>(n, 1.), std::vector<double>(n, 1.), std::vector<double>(n, 1.));
+        mesh.CreateFacesFromCells(implicitInteriorFaces);
+
+        //Flags and group match the faces with a single cell
+        auto& isBoundary = mesh.get_BoundaryPolygons();
+        auto faceToCell = mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYHEDRON)->get_adjacencySparseMatrix();
+        ASSERT_EQ(isBoundary.size(), mesh.get_nbPolygons());
+        std::vector<int> expected;
+        for (size_t face = 0; face != mesh.get_nbPolygons(); ++face)
+        {
+            EXPECT_EQ(isBoundary[face], faceToCell->rowPtr[face + 1] - faceToCell->rowPtr[face] == 1);
+            if (isBoundary[face])
+            {
+                expected.push_back(static_cast<int>(face));
+            }
+        }
+        auto boundary = mesh.get_PolygonCollection()->get_Group("BOUNDARY");
+        EXPECT_EQ(boundary->size_all(), static_cast<size_t>(6 * n * n));
+        EXPECT_EQ(boundary->get_indices(), expected);
+        for (auto polygon : *mesh.get_PolygonCollection()->get_Group("Top"))
+        {
+            EXPECT_TRUE(boundary->contains(polygon->get_localIndex()));
+        }
+    }
+}
+
+TEST(testCollection,testEdgeExtraction)
+{
+    //Same cells as testFaceExtraction, with a line on an edge of the hexahedron and a line across it
+    Mesh mesh;
+    const double coordinates[12][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 },
+                                        { 0.5, 0.5, 2 }, { 2, 0.5, 0 }, { 2, 0.5, 1 }, { 0.5, -1, 1.5 } };
+    std::vector<Point*> p;
+    for (int i = 0; i != 12; ++i)
+    {
+        p.push_back(mesh.addPoint(ELEMENTS::TYPE::VTK_VERTEX, i, "POINT", coordinates[i][0], coordinates[i][1], coordinates[i][2]).first);
+    }
+    mesh.addLine(ELEMENTS::TYPE::VTK_LINE, 0, "Edge", { p[1], p[0] });
+    mesh.addLine(ELEMENTS::TYPE::VTK_LINE, 1, "Diagonal", { p[0], p[6] });
+    mesh.addPolyhedron(ELEMENTS::TYPE::VTK_HEXAHEDRON, 0, "POLYHEDRON_GROUP_1", { p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7] });
+    mesh.addPolyhedron(ELEMENTS::TYPE::VTK_PYRAMID, 1, "POLYHEDRON_GROUP_1", { p[4], p[5], p[6], p[7], p[8] });
+    mesh.addPolyhedron(ELEMENTS::TYPE::VTK_WEDGE, 2, "POLYHEDRON_GROUP_1", { p[1], p[2], p[9], p[5], p[6], p[10] });
+    mesh.addPolyhedron(ELEMENTS::TYPE::VTK_TETRA, 3, "POLYHEDRON_GROUP_1", { p[4], p[5], p[8], p[11] });
+
+    //Edges are extracted on first request of the adjacency
+    auto cellToEdge = mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::LINE, ELEMENTS::FAMILY::POLYHEDRON);
+    ASSERT_NE(cellToEdge, nullptr);
+    auto lines = mesh.get_LineCollection();
+    auto polyhedra = mesh.get_PolyhedronCollection();
+    ASSERT_EQ(lines->size_all(), 25u);
+    EXPECT_EQ(lines->get_Group("Edge")->size_all(), 1u);
+
+    //Each cell sees the edges of its vtk edge list, the existing edge is reused
+    auto edgeOf = [](Point* a, Point* b) { return std::make_pair(std::min(a->get_localIndex(), b->get_localIndex()), std::max(a->get_localIndex(), b->get_localIndex())); };
+    std::map<std::pair<int, int>, int> lineIndex;
+    for (size_t i = 0; i != lines->size_all(); ++i)
+    {
+        auto& vertexList = (*lines)[i]->get_vertexList();
+        ASSERT_EQ(vertexList.size(), 2u);
+        EXPECT_EQ((*lines)[i]->get_localIndex(), static_cast<int>(i));
+        EXPECT_TRUE(lineIndex.insert(std::make_pair(edgeOf(vertexList[0], vertexList[1]), static_cast<int>(i))).second);
+    }
+    for (size_t i = 0; i != polyhedra->size_all(); ++i)
+    {
+        auto cell = (*polyhedra)[i];
+        auto table = ELEMENTS::edgeTableOf(cell->get_vtkType());
+        std::vector<int> expected;
+        for (int e = 0; e != table.nEdge; ++e)
+        {
+            auto edge = edgeOf(cell->get_vertexList()[table.vertex[e][0]], cell->get_vertexList()[table.vertex[e][1]]);
+            ASSERT_EQ(lineIndex.count(edge), 1u);
+            expected.push_back(lineIndex.at(edge));
+        }
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(cellToEdge->get_SingleElementAdjacency(static_cast<int>(i)).first, expected);
+        EXPECT_EQ(cellToEdge->get_SingleElementAdjacency(static_cast<int>(i)).second, std::vector<int>(expected.size(), static_cast<int>(i)));
+    }
+    EXPECT_EQ(lineIndex.at(edgeOf(p[0], p[1])), 0);
+
+    //Edge to point and edge to cell
+    auto edgeToPoint = mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::LINE, ELEMENTS::FAMILY::POINT, ELEMENTS::FAMILY::LINE);
+    EXPECT_EQ(edgeToPoint->get_SingleElementAdjacency(0).first, std::vector<int>({ 0, 1 }));
+    EXPECT_EQ(edgeToPoint->get_SingleElementAdjacency(1).first, std::vector<int>({ 0, 6 }));
+    auto edgeToCell = mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::LINE, ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYHEDRON);
+    EXPECT_EQ(edgeToCell->get_SingleElementAdjacency(0).first, std::vector<int>({ 0 }));
+    EXPECT_TRUE(edgeToCell->get_SingleElementAdjacency(1).first.empty());
+    EXPECT_EQ(edgeToCell->get_SingleElementAdjacency(lineIndex.at(edgeOf(p[4], p[5]))).first, std::vector<int>({ 0, 1, 3 }));
+    delete edgeToCell;
+
+    //Cartesian mesh
+    const int n = 5;
+    CartesianMesh cartesian(std::vector<double>(n, 1.), std::vector<double>(n, 1.), std::vector<double>(n, 1.));
+    cartesian.CreateEdgesFromCells();
+    EXPECT_EQ(cartesian.get_LineCollection()->size_all(), static_cast<size_t>(3 * n * (n + 1) * (n + 1)));
+}
@@ -0,0 +1,343 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * Copyright (c) 2018-2020 Lawrence Livermore National Security LLC
+ * Copyright (c) 2018-2020 The Board of Trustees of the Leland Stanford Junior University
+ * Copyright (c) 2018-2020 Total, S.A
+ * Copyright (c) 2020-     GEOSX Contributors
+ * All right reserved
+ *
+ * See top level LICENSE, COPYRIGHT, CONTRIBUTORS, NOTICE, and ACKNOWLEDGEMENTS files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+
+#include "Parallel/Communicator.hpp"
+#include "Mesh/CartesianMesh.hpp"
+#include "Elements/CellGeometry.hpp"
+#include "Mesh/Transmissibility.hpp"
+#include "Adjacency/Adjacency.hpp"
+#include "Elements/FaceKey.hpp"
+#include "gtest/gtest.h"
+
+using namespace PAMELA;
+
+int main(int argc, char **argv) {
+    Communicator::initialize();
+    ::testing::InitGoogleTest(&argc, argv);
+    int const result = RUN_ALL_TESTS();
+    Communicator::finalize();
+    return result;
+}
+
+TEST(testGeometry,testSingleCells)
+{
+    const double wedge[6][3] = { {0,0,0}, {1,0,0}, {0,1,0}, {0,0,1}, {1,0,1}, {0,1,1} };
+    const double pyramid[5][3] = { {0,0,0}, {1,0,0}, {1,1,0}, {0,1,0}, {0.5,0.5,1} };
+    std::vector<int> cells = { 0 };
+    CellGeometry geometry;
+    geometry.resize(1);
+
+    GEOMETRY::ComputeVolumesAndCentroids<ELEMENTS::TYPE::VTK_WEDGE>(cells, [&](int, int j, double& x, double& y, double& z)
+    {
+        x = wedge[j][0]; y = wedge[j][1]; z = wedge[j][2];
+    }, geometry);
+    EXPECT_NEAR(geometry.volume[0], 0.5, 1e-12);
+    EXPECT_NEAR(geometry.x[0], 1. / 3., 1e-12);
+    EXPECT_NEAR(geometry.z[0], 0.5, 1e-12);
+
+    GEOMETRY::ComputeVolumesAndCentroids<ELEMENTS::TYPE::VTK_PYRAMID>(cells, [&](int, int j, double& x, double& y, double& z)
+    {
+        x = pyramid[j][0]; y = pyramid[j][1]; z = pyramid[j][2];
+    }, geometry);
+    EXPECT_NEAR(geometry.volume[0], 1. / 3., 1e-12);
+    EXPECT_NEAR(geometry.y[0], 0.5, 1e-12);
+    EXPECT_NEAR(geometry.z[0], 0.25, 1e-12);
+}
+
+TEST(testGeometry,testBatchMatchesElements)
+{
+    const int n = 60;
+    CartesianMesh mesh(std::vector<double>(n, 1.), std::vector<double>(n, 2.), std::vector<double>(n, 0.5));
+    mesh.Distort(0.2);
+    auto polyhedra = mesh.get_PolyhedronCollection();
+    const auto nCells = polyhedra->size_all();
+
+    //Element by element
+    std::vector<double> volume(nCells), x(nCells), y(nCells), z(nCells);
+    for (size_t i = 0; i != nCells; ++i)
+    {
+        volume[i] = (*polyhedra)[i]->get_Volume();
+        auto centroid = (*polyhedra)[i]->get_centroidCoordinates();
+        x[i] = centroid[0]; y[i] = centroid[1]; z[i] = centroid[2];
+    }
+
+    //Batch
+    CellGeometry geometry;
+    mesh.ComputePolyhedronGeometry(geometry);
+
+    ASSERT_EQ(geometry.size(), nCells);
+    for (size_t i = 0; i != nCells; ++i)
+    {
+        EXPECT_NEAR(geometry.volume[i], volume[i], 1e-10);
+        EXPECT_NEAR(geometry.x[i], x[i], 1e-10);
+        EXPECT_NEAR(geometry.y[i], y[i], 1e-10);
+        EXPECT_NEAR(geometry.z[i], z[i], 1e-10);
+    }
+}
+
+//Throughput of the element by element and batch geometry, run with --gtest_also_run_disabled_tests
+TEST(testGeometry,DISABLED_benchmarkBatchGeometry)
+{
+    const int n = 60;
+    const int nRepeat = 5;
+    CartesianMesh mesh(std::vector<double>(n, 1.), std::vector<double>(n, 2.), std::vector<double>(n, 0.5));
+    mesh.Distort(0.2);
+    auto polyhedra = mesh.get_PolyhedronCollection();
+    const auto nCells = polyhedra->size_all();
+
+    //Element by element
+    double elementVolume = 0., elementX = 0.;
+    auto begin = std::chrono::steady_clock::now();
+    for (int r = 0; r != nRepeat; ++r)
+    {
+        for (size_t i = 0; i != nCells; ++i)
+        {
+            elementVolume += (*polyhedra)[i]->get_Volume();
+            elementX += (*polyhedra)[i]->get_centroidCoordinates()[0];
+        }
+    }
+    double elementTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    //Batch
+    CellGeometry geometry;
+    double batchVolume = 0., batchX = 0.;
+    begin = std::chrono::steady_clock::now();
+    for (int r = 0; r != nRepeat; ++r)
+    {
+        mesh.ComputePolyhedronGeometry(geometry);
+        batchVolume += std::accumulate(geometry.volume.begin(), geometry.volume.end(), 0.);
+        batchX += std::accumulate(geometry.x.begin(), geometry.x.end(), 0.);
+    }
+    double batchTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    EXPECT_NEAR(batchVolume, elementVolume, 1e-8 * elementVolume);
+    EXPECT_NEAR(batchX, elementX, 1e-8 * std::abs(elementX));
+
+    std::cout << "Element geometry: " << nRepeat * nCells / elementTime << " cells/s" << std::endl;
+    std::cout << "Batch geometry:   " << nRepeat * nCells / batchTime << " cells/s" << std::endl;
+}
+
+TEST(testGeometry,testGeometryCache)
+{
+    CartesianMesh mesh(std::vector<double>(10, 1.), std::vector<double>(10, 1.), std::vector<double>(10, 1.));
+    auto& geometry = mesh.get_PolyhedronGeometry();
+    ASSERT_EQ(geometry.size(), mesh.get_PolyhedronCollection()->size_all());
+    for (size_t i = 0; i != geometry.size(); ++i)
+    {
+        EXPECT_NEAR(geometry.volume[i], 1., 1e-12);
+        EXPECT_NEAR(geometry.xmax[i] - geometry.xmin[i], 1., 1e-12);
+        EXPECT_NEAR(geometry.x[i], 0.5 * (geometry.xmin[i] + geometry.xmax[i]), 1e-12);
+    }
+
+    //Moving points invalidates the cache
+    mesh.Distort(0.3);
+    auto& distorted = mesh.get_PolyhedronGeometry();
+    CellGeometry reference;
+    mesh.ComputePolyhedronGeometry(reference);
+    for (size_t i = 0; i != distorted.size(); ++i)
+    {
+        EXPECT_EQ(distorted.volume[i], reference.volume[i]);
+        EXPECT_EQ(distorted.z[i], reference.z[i]);
+        EXPECT_LE(distorted.ymin[i], distorted.y[i]);
+        EXPECT_GE(distorted.ymax[i], distorted.y[i]);
+    }
+}
+
+TEST(testGeometry,testFaceGeometry)
+{
+    CartesianMesh mesh(std::vector<double>(8, 1.), std::vector<double>(8, 2.), std::vector<double>(8, 0.5));
+    mesh.Distort(0.2);
+    mesh.CreateFacesFromCells();
+    auto polygons = mesh.get_PolygonCollection();
+    auto& geometry = mesh.get_PolygonGeometry();
+    ASSERT_EQ(geometry.size(), polygons->size_all());
+    for (size_t i = 0; i != geometry.size(); ++i)
+    {
+        auto face = (*polygons)[i];
+        auto normal = face->get_NormalVectorAndCoordinates().first;
+        auto centroid = face->get_centroidCoordinates();
+        EXPECT_NEAR(geometry.area[i], face->get_SurfaceArea(), 1e-10);
+        EXPECT_NEAR(geometry.nx[i], normal[0], 1e-10);
+        EXPECT_NEAR(geometry.ny[i], normal[1], 1e-10);
+        EXPECT_NEAR(geometry.nz[i], normal[2], 1e-10);
+        EXPECT_NEAR(geometry.x[i], centroid[0], 1e-10);
+        EXPECT_NEAR(geometry.y[i], centroid[1], 1e-10);
+        EXPECT_NEAR(geometry.z[i], centroid[2], 1e-10);
+    }
+}
+
+TEST(testGeometry,testTransmissibility)
+{
+    CartesianMesh mesh(std::vector<double>(4, 1.), std::vector<double>(4, 2.), std::vector<double>(4, 0.5));
+    mesh.CreateFacesFromCells();
+    auto properties = mesh.get_PolyhedronProperty_double();
+    properties->ReferenceProperty("PERMX");
+    properties->SetProperty("PERMX", std::vector<double>(mesh.get_PolyhedronCollection()->size_all(), 3.));
+    properties->ReferenceProperty("PERMZ");
+    properties->SetProperty("PERMZ", std::vector<double>(mesh.get_PolyhedronCollection()->size_all(), 0.5));
+
+    Transmissibility transmissibility;
+    TPFA::ComputeTransmissibility(&mesh, transmissibility);
+    auto& faces = mesh.get_PolygonGeometry();
+    ASSERT_EQ(transmissibility.size(), faces.size());
+
+    int nbInterior = 0;
+    for (size_t i = 0; i != transmissibility.size(); ++i)
+    {
+        //Cell size along the normal and permeability along the normal
+        double h = std::fabs(faces.nx[i]) * 1. + std::fabs(faces.ny[i]) * 2. + std::fabs(faces.nz[i]) * 0.5;
+        double k = (std::fabs(faces.nz[i]) > 0.5) ? 0.5 : 3.;
+        double half = faces.area[i] * k / (0.5 * h);
+        EXPECT_NEAR(transmissibility.halfTransmissibility0[i], half, 1e-10);
+        if (transmissibility.cell1[i] >= 0)
+        {
+            ++nbInterior;
+            EXPECT_NEAR(transmissibility.halfTransmissibility1[i], half, 1e-10);
+            EXPECT_NEAR(transmissibility.transmissibility[i], 0.5 * half, 1e-10);
+        }
+        else
+        {
+            EXPECT_EQ(transmissibility.transmissibility[i], 0.);
+        }
+    }
+    EXPECT_EQ(nbInterior, 3 * 4 * 4 * 3);
+
+    //Weighted cell to cell adjacency
+    auto adjacency = TPFA::CreateAdjacency(&mesh, "TPFA", transmissibility);
+    auto csr = adjacency->get_adjacencySparseMatrix();
+    EXPECT_EQ(csr->nnz, 2 * nbInterior);
+    for (int row = 0; row != csr->dimRow; ++row)
+    {
+        for (int k = csr->rowPtr[row]; k != csr->rowPtr[row + 1]; ++k)
+        {
+            auto face = csr->values[k];
+            EXPECT_TRUE((transmissibility.cell0[face] == row) || (transmissibility.cell1[face] == row));
+            EXPECT_GT(transmissibility.transmissibility[face], 0.);
+        }
+    }
+}
+
+TEST(testGeometry,testImplicitInteriorFaces)
+{
+    const int n = 12;
+    CartesianMesh explicitMesh(std::vector<double>(n, 1.), std::vector<double>(n, 2.), std::vector<double>(n, 0.5));
+    CartesianMesh implicitMesh(std::vector<double>(n, 1.), std::vector<double>(n, 2.), std::vector<double>(n, 0.5));
+    explicitMesh.CreateFacesFromCells();
+    implicitMesh.CreateFacesFromCells(true);
+
+    //Polygons are created for boundary faces only, interior faces come after them
+    const size_t nbFace = static_cast<size_t>(3 * n * n * (n + 1));
+    auto polygons = implicitMesh.get_PolygonCollection();
+    EXPECT_EQ(explicitMesh.get_PolygonCollection()->size_all(), nbFace);
+    EXPECT_EQ(implicitMesh.get_nbPolygons(), nbFace);
+    EXPECT_EQ(polygons->size_all(), static_cast<size_t>(6 * n * n));
+    EXPECT_EQ(implicitMesh.get_nbImplicitPolygons(), nbFace - polygons->size_all());
+    auto faceToCell = implicitMesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYHEDRON)->get_adjacencySparseMatrix();
+    ASSERT_EQ(faceToCell->dimRow, static_cast<int>(nbFace));
+    for (size_t face = 0; face != nbFace; ++face)
+    {
+        EXPECT_EQ(faceToCell->rowPtr[face + 1] - faceToCell->rowPtr[face], (face < polygons->size_all()) ? 1 : 2);
+    }
+
+    //Each cell sees the same faces in both modes
+    auto faceKeys = [](Mesh& mesh, int cell)
+    {
+        auto& connectivity = mesh.get_PolygonConnectivity();
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> keys;
+        for (auto face : mesh.getAdjacencySet()->get_TopologicalAdjacency(ELEMENTS::FAMILY::POLYHEDRON, ELEMENTS::FAMILY::POLYGON, ELEMENTS::FAMILY::POLYHEDRON)->get_SingleElementAdjacency(cell).first)
+        {
+            FaceKey key(connectivity.begin(face), static_cast<int>(connectivity.nVertex(face)));
+            keys.push_back(std::make_pair(key.w[0], key.w[1]));
+        }
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    };
+    for (int cell = 0; cell < n * n * n; cell += 7)
+    {
+        EXPECT_EQ(faceKeys(explicitMesh, cell), faceKeys(implicitMesh, cell));
+    }
+
+    //Geometry and transmissibilities cover the implicit faces
+    EXPECT_EQ(implicitMesh.get_PolygonGeometry().size(), nbFace);
+    double explicitArea = 0., implicitArea = 0.;
+    for (size_t face = 0; face != nbFace; ++face)
+    {
+        explicitArea += explicitMesh.get_PolygonGeometry().area[face];
+        implicitArea += implicitMesh.get_PolygonGeometry().area[face];
+    }
+    EXPECT_NEAR(explicitArea, implicitArea, 1e-8 * explicitArea);
+    auto properties = implicitMesh.get_PolyhedronProperty_double();
+    properties->ReferenceProperty("PERMX");
+    properties->SetProperty("PERMX", std::vector<double>(n * n * n, 1.));
+    Transmissibility transmissibility;
+    TPFA::ComputeTransmissibility(&implicitMesh, transmissibility);
+    for (size_t face = polygons->size_all(); face != nbFace; ++face)
+    {
+        EXPECT_GE(transmissibility.cell1[face], 0);
+    }
+
+    //Implicit faces can still be materialized, in place
+    auto areas = implicitMesh.get_PolygonGeometry().area;
+    implicitMesh.MaterializeImplicitPolygons();
+    ASSERT_EQ(polygons->size_all(), nbFace);
+    EXPECT_EQ(implicitMesh.get_nbImplicitPolygons(), 0u);
+    for (size_t face = 0; face < nbFace; face += 11)
+    {
+        EXPECT_EQ((*polygons)[face]->get_localIndex(), static_cast<int>(face));
+        EXPECT_NEAR((*polygons)[face]->get_SurfaceArea(), areas[face], 1e-10);
+    }
+}
+
+TEST(testGeometry,testAddPolygonAfterImplicitFaces)
+{
+    const int n = 3;
+    CartesianMesh mesh(std::vector<double>(n, 1.), std::vector<double>(n, 1.), std::vector<double>(n, 1.));
+    mesh.CreateFacesFromCells(true);
+    const size_t nbFace = static_cast<size_t>(3 * n * n * (n + 1));
+    ASSERT_GT(mesh.get_nbImplicitPolygons(), 0u);
+
+    //Implicit faces are materialized before the new polygon, which gets the last row of the connectivity
+    std::vector<Point*> vertices;
+    for (int i = 0; i != 3; ++i)
+    {
+        vertices.push_back(mesh.addPoint(ELEMENTS::TYPE::VTK_VERTEX, 1000 + i, "POINT", 10. + i, 10. + i * i, 10.).first);
+    }
+    auto added = mesh.addPolygon(ELEMENTS::TYPE::VTK_TRIANGLE, 1000, "EXTRA", vertices);
+    ASSERT_TRUE(added.second);
+    auto polygons = mesh.get_PolygonCollection();
+    auto& connectivity = mesh.get_PolygonConnectivity();
+    EXPECT_EQ(mesh.get_nbImplicitPolygons(), 0u);
+    ASSERT_EQ(polygons->size_all(), nbFace + 1);
+    ASSERT_EQ(connectivity.size(), nbFace + 1);
+    EXPECT_EQ(added.first->get_localIndex(), static_cast<int>(nbFace));
+
+    //Every polygon matches its connectivity row
+    for (size_t face = 0; face != polygons->size_all(); ++face)
+    {
+        auto& vertexList = (*polygons)[face]->get_vertexList();
+        ASSERT_EQ(vertexList.size(), connectivity.nVertex(face));
+        for (size_t i = 0; i != vertexList.size(); ++i)
+        {
+            EXPECT_EQ(static_cast<CellConnectivity::index_type>(vertexList[i]->get_storeIndex()), connectivity.begin(face)[i]);
+        }
+    }
+}